@@ -108,7 +108,6 @@ void VCAI::heroMoved(const TryMoveHero & details)
 
 	validateObject(details.id); //enemy hero may have left visible area
 	auto hero = cb->getHero(details.id);
-	cachedSectorMaps.clear();
 
 	const int3 from = CGHeroInstance::convertPosition(details.start, false),
 		to = CGHeroInstance::convertPosition(details.end, false);
@@ -395,8 +394,6 @@ void VCAI::newObject(const CGObjectInstance * obj)
 	NET_EVENT_HANDLER;
 	if(obj->isVisitable())
 		addVisitableObj(obj);
-
-	cachedSectorMaps.clear();
 }
 
 void VCAI::objectRemoved(const CGObjectInstance *obj)
@@ -423,8 +420,6 @@ void VCAI::objectRemoved(const CGObjectInstance *obj)
 		}
 	}
 
-	cachedSectorMaps.clear(); //invalidate all paths
-
 	//TODO
 	//there are other places where CGObjectinstance ptrs are stored...
 	//
@@ -2023,21 +2018,49 @@ bool VCAI::moveHeroToTile(int3 dst, HeroPtr h)
 			if(endpos == h->visitablePos())
 				continue;
 
-			if((i-2 >= 0) // Check there is node after next one; otherwise transit is pointless
-				&& (CGTeleport::isConnected(nextObjectTop, getObj(path.nodes[i-2].coord, false))
-					|| CGTeleport::isTeleport(nextObjectTop)))
-			{ // Hero should be able to go through object if it's allow transit
-				doMovement(endpos, true);
+			//ordinary steps are sent as one request, server stops at first visit, battle or dialog
+			std::vector<std::pair<int3, bool>> steps;
+			int last = i-1;
+			for(; last >= 0; last--)
+			{
+				auto stepObjectTop = getObj(path.nodes[last].coord, false);
+				bool teleportAhead = (last-1 >= 0) // Check there is node after next one; otherwise transit is pointless
+					&& (CGTeleport::isConnected(stepObjectTop, getObj(path.nodes[last-1].coord, false))
+						|| CGTeleport::isTeleport(stepObjectTop));
+
+				if(last < i-1 && (path.nodes[last].turns || isTeleportAction(path.nodes[last].action) || teleportAhead))
+					break;
+
+				// Hero should be able to go through object if it's allow transit
+				bool transit = teleportAhead || path.nodes[last].layer == EPathfindingLayer::AIR;
+				steps.push_back(std::make_pair(CGHeroInstance::convertPosition(path.nodes[last].coord, true), transit));
+
+				if(teleportAhead)
+				{
+					last--;
+					break;
+				}
 			}
-			else if(path.nodes[i-1].layer == EPathfindingLayer::AIR)
-				doMovement(endpos, true);
+			last++;
+
+			if(steps.size() == 1)
+				doMovement(endpos, steps.front().second);
 			else
-				doMovement(endpos, false);
+				cb->moveHero(*h, steps);
 
 			afterMovementCheck();
 
 			if(teleportChannelProbingList.size())
 				doChannelProbing();
+
+			//server stopped the run early (visit, battle or dialog) - don't replay the interrupted step
+			if(steps.size() > 1)
+			{
+				if(path.nodes[last].coord != h->visitablePos())
+					break;
+
+				i = last + 1;
+			}
 		}
 	}
 	if (h)
@@ -2890,12 +2913,16 @@ std::shared_ptr<SectorMap> VCAI::getCachedSectorMap(HeroPtr h)
 {
 	auto it = cachedSectorMaps.find(h);
 	if (it != cachedSectorMaps.end())
-		return it->second;
-	else
 	{
-		cachedSectorMaps[h] = std::make_shared<SectorMap>(h);
-		return cachedSectorMaps[h];
+		//sectors only depend on visible tiles and objects on them - both are recorded in game state journal,
+		//changes hidden by fog of war do not matter unless visibility itself changed
+		auto & sm = it->second;
+		if (!cb->hasTileChangesSince(sm->journalVersion) && sm->visibleTiles->getVersion() == cb->getVisibleTilesView().getVersion())
+			return sm;
 	}
+
+	cachedSectorMaps[h] = std::make_shared<SectorMap>(h);
+	return cachedSectorMaps[h];
 }
 
 AIStatus::AIStatus()
@@ -3080,9 +3107,10 @@ bool SectorMap::markIfBlocked(TSectorID &sec, crint3 pos)
 
 void SectorMap::update()
 {
-	visibleTiles = cb->getAllVisibleTiles();
-	auto shape = visibleTiles->shape();
-	sector.resize(boost::extents[shape[0]][shape[1]][shape[2]]);
+	visibleTiles = cb->getVisibleTilesView();
+	journalVersion = cb->getJournalVersion();
+	int3 size = visibleTiles->getSize();
+	sector.resize(boost::extents[size.x][size.y][size.z]);
 
 	clear();
 	int curSector = 3; //0 is invisible, 1 is not explored
@@ -3549,11 +3577,10 @@ SectorMap::TSectorID & SectorMap::retreiveTile(crint3 pos)
 	return retreiveTileN(sector, pos);
 }
 
-TerrainTile* SectorMap::getTile(crint3 pos) const
+const TerrainTile* SectorMap::getTile(crint3 pos) const
 {
-	//out of bounds access should be handled by boost::multi_array
-	//still we cached this array to avoid any checks
-	return visibleTiles->operator[](pos.x)[pos.y][pos.z];
+	//view reads tiles directly from the map, nothing is copied
+	return visibleTiles->getTile(pos);
 }
 
 std::vector<const CGObjectInstance *> SectorMap::getNearbyObjs(HeroPtr h, bool sectorsAround)
@@ -98,7 +98,8 @@ struct SectorMap
 	//std::vector<std::vector<std::vector<unsigned char>>> pathfinderSector;
 
 	std::map<int, Sector> infoOnSectors;
-	std::shared_ptr<boost::multi_array<TerrainTile*, 3>> visibleTiles;
+	boost::optional<CVisibleTilesView> visibleTiles;
+	ui64 journalVersion; //game state the sectors were computed for
 
 	SectorMap();
 	SectorMap(HeroPtr h);
@@ -112,7 +113,7 @@ struct SectorMap
 	TSectorID & retreiveTile(crint3 pos);
 	TSectorID & retreiveTileN(TSectorArray &vectors, const int3 &pos);
 	const TSectorID & retreiveTileN(const TSectorArray &vectors, const int3 &pos);
-	TerrainTile* getTile(crint3 pos) const;
+	const TerrainTile* getTile(crint3 pos) const;
 	std::vector<const CGObjectInstance *> getNearbyObjs(HeroPtr h, bool sectorsAround);
 
 	void makeParentBFS(crint3 source);
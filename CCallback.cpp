@@ -43,6 +43,13 @@ bool CCallback::moveHero(const CGHeroInstance *h, int3 dst, bool transit)
 	return true;
 }
 
+bool CCallback::moveHero(const CGHeroInstance *h, const std::vector<std::pair<int3, bool>> & steps)
+{
+	MoveHeroPath pack(h->id,steps);
+	sendRequest(&pack);
+	return true;
+}
+
 int CCallback::selectionMade(int selection, QueryID queryID)
 {
 	JsonNode reply(JsonNode::DATA_INTEGER);
@@ -295,7 +302,7 @@ int3 CCallback::getGuardingCreaturePosition(int3 tile)
 	if (!gs->map->isInTheMap(tile))
 		return int3(-1,-1,-1);
 
-	return gs->map->guardingCreaturePositions[tile.x][tile.y][tile.z];
+	return gs->map->guardingCreaturePositions[gs->map->getTileIndex(tile)];
 }
 
 void CCallback::calculatePaths( const CGHeroInstance *hero, CPathsInfo &out)
@@ -251,6 +251,7 @@ int main(int argc, char * argv[])
 		("spectate-battle-speed", po::value<int>(), "battle animation speed for spectator")
 		("spectate-skip-battle", "skip battles in spectator view")
 		("spectate-skip-battle-result", "skip battle result window")
+		("fast-forward", "skip playback of AI hero movement, only with --spectate, implied by --headless")
 		("onlyAI", "runs without human player, all players will be default AI")
 		("headless", "runs without GUI, implies --onlyAI")
 		("ai", po::value<std::vector<std::string>>(), "AI to be used for the player, can be specified several times for the consecutive players")
@@ -519,6 +520,7 @@ int main(int argc, char * argv[])
 		if(vm.count("spectate-battle-speed"))
 			session["spectate-battle-speed"].Float() = vm["spectate-battle-speed"].as<int>();
 	}
+	session["fast-forward"].Bool() = session["headless"].Bool() || (session["spectate"].Bool() && vm.count("fast-forward"));
 	if(!session["testmap"].isNull())
 	{
 		startTestMap(session["testmap"].String());
@@ -318,7 +318,9 @@ void CPlayerInterface::heroMoved(const TryMoveHero & details)
 	}
 
 	ui32 speed = 0;
-	if(settings["session"]["spectate"].Bool())
+	if(settings["session"]["fast-forward"].Bool())
+		speed = 0; //movement may be merged from several steps - no animation
+	else if(settings["session"]["spectate"].Bool())
 	{
 		if(!settings["session"]["spectate-hero-speed"].isNull())
 			speed = settings["session"]["spectate-hero-speed"].Integer();
@@ -355,6 +357,7 @@ void CPlayerInterface::heroMoved(const TryMoveHero & details)
 		adventureInt->updateScreen = true;
 #endif
 		adventureInt->show(screen);
+		GH.invalidate(adventureInt->pos);
 		{
 			//evil returns here ...
 			//todo: get rid of it
@@ -1242,8 +1245,7 @@ void CPlayerInterface::tileRevealed(const std::unordered_set<int3, ShashInt3> &p
 {
 	EVENT_HANDLER_CALLED_BY_CLIENT;
 	//FIXME: wait for dialog? Magi hut/eye would benefit from this but may break other areas
-	for (auto & po : pos)
-		adventureInt->minimap.showTile(po);
+	adventureInt->minimap.updateTiles(pos);
 	if (!pos.empty())
 		GH.totalRedraw();
 }
@@ -1251,8 +1253,7 @@ void CPlayerInterface::tileRevealed(const std::unordered_set<int3, ShashInt3> &p
 void CPlayerInterface::tileHidden(const std::unordered_set<int3, ShashInt3> &pos)
 {
 	EVENT_HANDLER_CALLED_BY_CLIENT;
-	for (auto & po : pos)
-		adventureInt->minimap.hideTile(po);
+	adventureInt->minimap.updateTiles(pos);
 	if (!pos.empty())
 		GH.totalRedraw();
 }
@@ -2372,6 +2373,7 @@ void CPlayerInterface::acceptTurn()
 
 	adventureInt->updateNextHero(nullptr);
 	adventureInt->showAll(screen);
+	GH.invalidate(adventureInt->pos);
 
 	if (settings["session"]["autoSkip"].Bool() && !LOCPLINT->shiftPressed())
 	{
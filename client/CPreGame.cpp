@@ -54,6 +54,7 @@
 #include "widgets/TextControls.h"
 #include "windows/InfoWindows.h"
 #include "../lib/mapping/CMapService.h"
+#include "../lib/mapping/CMapHeaderIndex.h"
 #include "../lib/CRandomGenerator.h"
 #include "../lib/CondSh.h"
 
@@ -1117,22 +1118,26 @@ void SelectionTab::parseMaps(const std::unordered_set<ResourceID> &files)
 {
 	logGlobal->debug("Parsing %d maps", files.size());
 	allItems.clear();
+
+	// headers of maps that were seen before are taken from index, only new and changed maps are parsed
+	CMapHeaderIndex index;
+	index.load();
+	index.update(files);
+	index.save();
+
 	for(auto & file : files)
 	{
-		try
-		{
-			CMapInfo mapInfo;
-			mapInfo.mapInit(file.getName());
+		const CMapHeader * header = index.getHeader(file.getName());
+		if(!header) //invalid map, error was reported during parsing
+			continue;
 
-			// ignore unsupported map versions (e.g. WoG maps without WoG)
-			// but accept VCMI maps
-			if((mapInfo.mapHeader->version >= EMapFormat::VCMI) || (mapInfo.mapHeader->version <= CGI->modh->settings.data["textData"]["mapVersion"].Float()))
-				allItems.push_back(std::move(mapInfo));
-		}
-		catch(std::exception & e)
-		{
-			logGlobal->error("Map %s is invalid. Message: %s", file.getName(), e.what());
-		}
+		CMapInfo mapInfo;
+		mapInfo.mapInit(file.getName(), *header);
+
+		// ignore unsupported map versions (e.g. WoG maps without WoG)
+		// but accept VCMI maps
+		if((mapInfo.mapHeader->version >= EMapFormat::VCMI) || (mapInfo.mapHeader->version <= CGI->modh->settings.data["textData"]["mapVersion"].Float()))
+			allItems.push_back(std::move(mapInfo));
 	}
 }
 
@@ -3872,6 +3877,7 @@ void CBonusSelection::CRegion::clickLeft( tribool down, bool previousState )
 		owner->selectMap(myNumber, false);
 		owner->highlightedRegion = this;
 		parent->showAll(screen);
+		GH.invalidate(parent->pos);
 	}
 }
 
@@ -120,6 +120,7 @@ void CClient::init()
 		connectionHandler.reset();
 	}
 	pathInfo = nullptr;
+	pendingMove.reset();
 	applier = new CApplier<CBaseForCLApply>();
 	registerTypesClientPacks1(*applier);
 	registerTypesClientPacks2(*applier);
@@ -678,6 +679,8 @@ void CClient::handlePack( CPack * pack )
 	if(apply)
 	{
 		boost::unique_lock<boost::recursive_mutex> guiLock(*CPlayerInterface::pim);
+		if(pendingMove && !continuesPendingMove(pack))
+			flushPendingMove();
 		apply->applyOnClBefore(this, pack);
 		logNetwork->trace("\tMade first apply on cl");
 		gs->apply(pack);
@@ -692,6 +695,90 @@ void CClient::handlePack( CPack * pack )
 	delete pack;
 }
 
+bool CClient::isFastForwarded(const TryMoveHero & move) const
+{
+	if(!settings["session"]["fast-forward"].Bool() || move.result != TryMoveHero::SUCCESS)
+		return false;
+
+	const CGHeroInstance * h = getHero(move.id);
+	if(!h)
+		return false;
+
+	//movement of human player is always played step by step
+	auto it = playerint.find(h->tempOwner);
+	return it == playerint.end() || !it->second->human;
+}
+
+bool CClient::continuesPendingMove(const CPack * pack) const
+{
+	//only reply to request that caused the step may come between steps
+	if(dynamic_cast<const PackageApplied *>(pack))
+		return true;
+
+	//merged steps share one humanKnows, it decides how map handler shows the hero
+	auto move = dynamic_cast<const TryMoveHero *>(pack);
+	return move && move->id == pendingMove->id && isFastForwarded(*move) && isMoveKnownToHuman(*move) == pendingMove->humanKnows;
+}
+
+bool CClient::isMoveKnownToHuman(const TryMoveHero & move) const
+{
+	for(auto & i : playerint)
+	{
+		auto ps = gs->getPlayer(i.first);
+		if(ps && ps->human && (gs->isVisible(move.start - int3(1, 0, 0), i.first) || gs->isVisible(move.end - int3(1, 0, 0), i.first)))
+			return true;
+	}
+	return false;
+}
+
+bool CClient::hasPendingMove(ObjectInstanceID hero) const
+{
+	return pendingMove && pendingMove->id == hero;
+}
+
+void CClient::addPendingMove(const TryMoveHero & move, const std::set<PlayerColor> & observers)
+{
+	if(!pendingMove)
+	{
+		pendingMove = make_unique<TryMoveHero>(move);
+	}
+	else
+	{
+		pendingMove->end = move.end;
+		pendingMove->movePoints = move.movePoints;
+		pendingMove->fowRevealed.insert(move.fowRevealed.begin(), move.fowRevealed.end());
+	}
+	pendingMoveObservers.insert(observers.begin(), observers.end());
+}
+
+void CClient::flushPendingMove()
+{
+	std::unique_ptr<TryMoveHero> move = std::move(pendingMove);
+	std::set<PlayerColor> observers = std::move(pendingMoveObservers);
+	pendingMoveObservers.clear();
+
+	const CGHeroInstance * h = getHero(move->id);
+	logNetwork->trace("Showing fast-forwarded movement of hero %d from %s to %s", move->id.getNum(), move->start.toString(), move->end.toString());
+
+	//AI interfaces already got revealed tiles step by step
+	if(!move->fowRevealed.empty())
+	{
+		for(auto & i : playerint)
+			if(i.second->human && getPlayerRelations(i.first, h->tempOwner) != PlayerRelations::ENEMIES)
+				i.second->tileRevealed(move->fowRevealed);
+	}
+
+	for(auto & color : observers)
+	{
+		auto it = playerint.find(color);
+		if(it != playerint.end())
+			it->second->heroMoved(*move);
+	}
+
+	if(!move->humanKnows && CGI->mh)
+		CGI->mh->printObject(h);
+}
+
 void CClient::finishCampaign( std::shared_ptr<CCampaignState> camp )
 {
 }
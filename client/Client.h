@@ -31,6 +31,7 @@ struct SharedMemory;
 class CClient;
 class CScriptingModule;
 struct CPathsInfo;
+struct TryMoveHero;
 class BinaryDeserializer;
 class BinarySerializer;
 namespace boost { class thread; }
@@ -123,6 +124,11 @@ public:
 class CClient : public IGameCallback
 {
 	std::unique_ptr<CPathsInfo> pathInfo;
+
+	/// fast-forward playback: consecutive steps of AI hero merged into one movement
+	std::unique_ptr<TryMoveHero> pendingMove;
+	std::set<PlayerColor> pendingMoveObservers; //interfaces that have seen any of merged steps
+	bool continuesPendingMove(const CPack * pack) const;
 public:
 	std::map<PlayerColor,std::shared_ptr<CCallback> > callbacks; //callbacks given to player interfaces
 	std::map<PlayerColor,std::shared_ptr<CBattleCallback> > battleCallbacks; //callbacks given to player interfaces
@@ -239,6 +245,12 @@ public:
 	int sendRequest(const CPack *request, PlayerColor player); //returns ID given to that request
 
 	void handlePack( CPack * pack ); //applies the given pack and deletes it
+
+	bool isFastForwarded(const TryMoveHero & move) const; //step that is shown to interfaces merged with following ones
+	bool isMoveKnownToHuman(const TryMoveHero & move) const; //start or end of the step is visible to some human player
+	bool hasPendingMove(ObjectInstanceID hero) const;
+	void addPendingMove(const TryMoveHero & move, const std::set<PlayerColor> & observers);
+	void flushPendingMove(); //shows merged movement to interfaces
 	void battleStarted(const BattleInfo * info);
 	void commenceTacticPhaseForInt(std::shared_ptr<CBattleGameInterface> battleInt); //will be called as separate thread
 
@@ -367,6 +367,7 @@ std::shared_ptr<CAnimation> Graphics::getAnimation(const ObjectTemplate & info)
 	}
 
 	ret = std::make_shared<CAnimation>(info.animationFile);
+	ret->setEvictable();
 	mapObjectAnimations[info.animationFile] = ret;
 
 	ret->preload();
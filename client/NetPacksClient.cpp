@@ -169,6 +169,9 @@ void SetMovePoints::applyCl(CClient *cl)
 
 void FoWChange::applyCl(CClient *cl)
 {
+	//interfaces get all changed tiles together
+	std::unordered_set<int3, ShashInt3> changed = tiles;
+	TileRun::toTiles(runs, changed);
 	for(auto &i : cl->playerint)
 	{
 		if(cl->getPlayerRelations(i.first, player) == PlayerRelations::SAME_PLAYER && waitForDialogs && LOCPLINT == i.second.get())
@@ -178,9 +181,9 @@ void FoWChange::applyCl(CClient *cl)
 		if(cl->getPlayerRelations(i.first, player) != PlayerRelations::ENEMIES)
 		{
 			if(mode)
-				i.second->tileRevealed(tiles);
+				i.second->tileRevealed(changed);
 			else
-				i.second->tileHidden(tiles);
+				i.second->tileHidden(changed);
 		}
 	}
 	cl->invalidatePaths();
@@ -364,19 +367,15 @@ void TryMoveHero::applyFirstCl(CClient *cl)
 	CGHeroInstance *h = GS(cl)->getHero(id);
 
 	//check if playerint will have the knowledge about movement - if not, directly update maphandler
-	for(auto i=cl->playerint.begin(); i!=cl->playerint.end(); i++)
-	{
-		auto ps = GS(cl)->getPlayer(i->first);
-		if(ps && (GS(cl)->isVisible(start - int3(1, 0, 0), i->first) || GS(cl)->isVisible(end - int3(1, 0, 0), i->first)))
-		{
-			if(ps->human)
-				humanKnows = true;
-		}
-	}
+	humanKnows = cl->isMoveKnownToHuman(*this);
 
 	if(!CGI->mh)
 		return;
 
+	//hero was hidden by first of merged steps
+	if(cl->hasPendingMove(id))
+		return;
+
 	if(result == TELEPORTATION  ||  result == EMBARK  ||  result == DISEMBARK  ||  !humanKnows)
 		CGI->mh->hideObject(h, result == EMBARK && humanKnows);
 
@@ -399,9 +398,12 @@ void TryMoveHero::applyCl(CClient *cl)
 	}
 
 	PlayerColor player = h->tempOwner;
+	//in fast-forward mode only owner and AIs get every step, everyone else sees merged movement
+	bool fastForwarded = cl->isFastForwarded(*this);
+	std::set<PlayerColor> observers;
 
 	for(auto &i : cl->playerint)
-		if(cl->getPlayerRelations(i.first, player) != PlayerRelations::ENEMIES)
+		if(cl->getPlayerRelations(i.first, player) != PlayerRelations::ENEMIES && !(fastForwarded && i.second->human))
 			i.second->tileRevealed(fowRevealed);
 
 	//notify interfaces about move
@@ -410,10 +412,19 @@ void TryMoveHero::applyCl(CClient *cl)
 		if(GS(cl)->isVisible(start - int3(1, 0, 0), i->first)
 			|| GS(cl)->isVisible(end - int3(1, 0, 0), i->first))
 		{
-			i->second->heroMoved(*this);
+			if(fastForwarded && i->first != player)
+				observers.insert(i->first);
+			else
+				i->second->heroMoved(*this);
 		}
 	}
 
+	if(fastForwarded)
+	{
+		cl->addPendingMove(*this, observers);
+		return; //maphandler will be updated with merged movement
+	}
+
 	//maphandler didn't get update from playerint, do it now
 	//TODO: restructure nicely
 	if(!humanKnows && CGI->mh)
@@ -155,9 +155,9 @@ CCreatureAnimation::CCreatureAnimation(const std::string & name_, TSpeedControll
 	forward = std::make_shared<CAnimation>(name_);
 	reverse = std::make_shared<CAnimation>(name_);
 
-	//todo: optimize
-	forward->preload();
-	reverse->preload();
+	//frames are decoded in background, only first frame of default group is awaited below
+	forward->preloadAsync();
+	reverse->preloadAsync();
 
 	// if necessary, add one frame into vcmi-only group DEAD
 	if(forward->size(CCreatureAnim::DEAD) == 0)
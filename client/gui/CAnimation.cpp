@@ -21,6 +21,8 @@
 #include "../lib/filesystem/ISimpleResourceLoader.h"
 #include "../lib/JsonNode.h"
 #include "../lib/CRandomGenerator.h"
+#include "../lib/CConfigHandler.h"
+#include "../lib/CThreadHelper.h"
 
 class SDLImageLoader;
 class CompImageLoader;
@@ -96,6 +98,7 @@ public:
 	void setFlagColor(PlayerColor player) override;
 	int width() const override;
 	int height() const override;
+	size_t memoryUsage() const override;
 
 	void horizontalFlip() override;
 	void verticalFlip() override;
@@ -156,6 +159,7 @@ public:
 	void setFlagColor(PlayerColor player) override;
 	int width() const override;
 	int height() const override;
+	size_t memoryUsage() const override;
 
 	void horizontalFlip() override;
 	void verticalFlip() override;
@@ -992,6 +996,13 @@ int SDLImage::height() const
 	return fullSize.y;
 }
 
+size_t SDLImage::memoryUsage() const
+{
+	if(!surf)
+		return sizeof(SDLImage);
+	return sizeof(SDLImage) + surf->pitch * surf->h;
+}
+
 void SDLImage::horizontalFlip()
 {
 	margins.y = fullSize.y - surf->h - margins.y;
@@ -1281,6 +1292,12 @@ int CompImage::height() const
 	return fullSize.y;
 }
 
+size_t CompImage::memoryUsage() const
+{
+	//size of RLE data is not stored, assume it is not larger than uncompressed sprite
+	return sizeof(CompImage) + sprite.w * sprite.h + sprite.h * sizeof(ui32) + (palette ? 256 * sizeof(SDL_Color) : 0);
+}
+
 CompImage::~CompImage()
 {
 	free(surf);
@@ -1318,6 +1335,132 @@ void CompImage::exportBitmap(const boost::filesystem::path & path) const
  *  CAnimation for animations handling, can load part of file if needed  *
  *************************************************************************/
 
+/// Decoding of single def frame, executed by CFrameDecoder
+/// If no worker has started it yet, thread waiting for result decodes frame by itself
+class CFrameDecodeTask
+{
+	std::function<IImage *()> decoder;
+	std::atomic<bool> taken;
+	bool done;
+	IImage * result;
+	boost::mutex mx;
+	boost::condition_variable cond;
+
+	void finish(IImage * image)
+	{
+		TLockGuard lock(mx);
+		result = image;
+		done = true;
+		cond.notify_all();
+	}
+public:
+	CFrameDecodeTask(std::function<IImage *()> Decoder):
+		decoder(Decoder),
+		taken(false),
+		done(false),
+		result(nullptr)
+	{
+	}
+
+	void run()
+	{
+		if(taken.exchange(true))
+			return;
+
+		IImage * image = nullptr;
+		try
+		{
+			image = decoder();
+		}
+		catch(const std::exception & e)
+		{
+			logAnim->error("Failed to decode frame: %s", e.what());
+		}
+		finish(image);
+	}
+
+	//task will not be executed anymore, wait() returns nullptr unless decoding is already in progress
+	void cancel()
+	{
+		if(!taken.exchange(true))
+			finish(nullptr);
+	}
+
+	IImage * wait()
+	{
+		run();
+
+		boost::unique_lock<boost::mutex> lock(mx);
+		while(!done)
+			cond.wait(lock);
+		return result;
+	}
+};
+
+/// Pool of worker threads decoding frames of asynchronously loaded animations
+class CFrameDecoder
+{
+	std::deque<std::shared_ptr<CFrameDecodeTask>> queue;
+	boost::mutex mx;
+	boost::condition_variable cond;
+	boost::thread_group workers;
+	bool stopping;
+
+	void workerLoop()
+	{
+		setThreadName("CFrameDecoder::workerLoop");
+
+		while(true)
+		{
+			std::shared_ptr<CFrameDecodeTask> task;
+			{
+				boost::unique_lock<boost::mutex> lock(mx);
+				while(queue.empty() && !stopping)
+					cond.wait(lock);
+				if(stopping)
+					return;
+				task = queue.front();
+				queue.pop_front();
+			}
+			task->run();
+		}
+	}
+
+	CFrameDecoder():
+		stopping(false)
+	{
+		//one core is left for GUI thread
+		int threadsCount = std::max(1, static_cast<int>(boost::thread::hardware_concurrency()) - 1);
+		for(int i = 0; i < threadsCount; i++)
+			workers.create_thread(std::bind(&CFrameDecoder::workerLoop, this));
+	}
+public:
+	~CFrameDecoder()
+	{
+		{
+			TLockGuard lock(mx);
+			stopping = true;
+		}
+		cond.notify_all();
+		workers.join_all();
+	}
+
+	static CFrameDecoder & get()
+	{
+		static CFrameDecoder instance;
+		return instance;
+	}
+
+	void submit(std::shared_ptr<CFrameDecodeTask> task)
+	{
+		{
+			TLockGuard lock(mx);
+			queue.push_back(task);
+		}
+		cond.notify_one();
+	}
+};
+
 IImage * CAnimation::getFromExtraDef(std::string filename)
 {
 	size_t pos = filename.find(':');
@@ -1348,13 +1491,17 @@ bool CAnimation::loadFrame(size_t frame, size_t group)
 		return false;
 	}
 
-	IImage * image = getImage(frame, group, false);
+	finishPendingFrame(frame, group);
+
+	IImage * image = findImage(frame, group);
 	if(image)
 	{
 		image->increaseRef();
 		return true;
 	}
 
+	bool loaded = false;
+
 	//try to get image from def
 	if(source[group][frame].getType() == JsonNode::DATA_NULL)
 	{
@@ -1365,37 +1512,46 @@ bool CAnimation::loadFrame(size_t frame, size_t group)
 			if(vstd::contains(frameList, group) && frameList.at(group) > frame) // frame is present
 			{
 				if(compressed)
-					images[group][frame] = new CompImage(defFile, frame, group);
+					image = new CompImage(defFile, frame, group);
 				else
-					images[group][frame] = new SDLImage(defFile, frame, group);
-				return true;
+					image = new SDLImage(defFile, frame, group);
+				loaded = true;
 			}
 		}
-		// still here? image is missing
 
-		printError(frame, group, "LoadFrame");
-		images[group][frame] = new SDLImage("DEFAULT", compressed);
+		if(!loaded)
+		{
+			printError(frame, group, "LoadFrame");
+			image = new SDLImage("DEFAULT", compressed);
+		}
 	}
 	else //load from separate file
 	{
-		IImage * img = getFromExtraDef(source[group][frame]["file"].String());
-		if(!img)
-			img = new SDLImage(source[group][frame]);
-
-		images[group][frame] = img;
-		return true;
+		image = getFromExtraDef(source[group][frame]["file"].String());
+		if(!image)
+			image = new SDLImage(source[group][frame]);
+		loaded = true;
 	}
-	return false;
+
+	images[group][frame] = image;
+
+	if(evictable)
+		CAnimationFrameCache::get().frameLoaded(this, frame, group, image->memoryUsage());
+	return loaded;
 }
 
 bool CAnimation::unloadFrame(size_t frame, size_t group)
 {
-	IImage *image = getImage(frame, group, false);
+	finishPendingFrame(frame, group);
+
+	IImage *image = findImage(frame, group);
 	if (image)
 	{
 		//decrease ref count for image and delete if needed
 		if (image->decreaseRef())
 		{
+			if(evictable)
+				CAnimationFrameCache::get().frameUnloaded(this, frame, group);
 			delete image;
 			images[group].erase(frame);
 		}
@@ -1406,6 +1562,107 @@ bool CAnimation::unloadFrame(size_t frame, size_t group)
 	return false;
 }
 
+void CAnimation::evictFrame(size_t frame, size_t group)
+{
+	auto groupIter = images.find(group);
+	if(groupIter == images.end())
+		return;
+
+	auto imageIter = groupIter->second.find(frame);
+	if(imageIter == groupIter->second.end())
+		return;
+
+	delete imageIter->second;
+	groupIter->second.erase(imageIter);
+	if(groupIter->second.empty())
+		images.erase(groupIter);
+}
+
+void CAnimation::loadFrameAsync(size_t frame, size_t group)
+{
+	const auto key = std::make_pair(group, frame);
+
+	auto pendingIter = pendingFrames.find(key);
+	if(pendingIter != pendingFrames.end())
+	{
+		pendingIter->second.refCount++;
+		return;
+	}
+
+	bool inDefFile = defFile && frame < size(group) && source[group][frame].getType() == JsonNode::DATA_NULL;
+	if(inDefFile)
+	{
+		auto frameList = defFile->getEntries();
+		inDefFile = vstd::contains(frameList, group) && frameList.at(group) > frame;
+	}
+
+	//already loaded frames only need their refCount updated, separate files are not decoded in background
+	if(!inDefFile || findImage(frame, group))
+	{
+		loadFrame(frame, group);
+		return;
+	}
+
+	CDefFile * file = defFile;
+	const bool rle = compressed;
+
+	PendingFrame pending;
+	pending.task = std::make_shared<CFrameDecodeTask>([=]() -> IImage *
+	{
+		if(rle)
+			return new CompImage(file, frame, group);
+		return new SDLImage(file, frame, group);
+	});
+	pending.refCount = 1;
+	pending.horizontalFlip = false;
+	pending.verticalFlip = false;
+
+	pendingFrames[key] = pending;
+	CFrameDecoder::get().submit(pending.task);
+}
+
+bool CAnimation::finishPendingFrame(size_t frame, size_t group)
+{
+	auto pendingIter = pendingFrames.find(std::make_pair(group, frame));
+	if(pendingIter == pendingFrames.end())
+		return false;
+
+	const PendingFrame pending = pendingIter->second;
+	pendingFrames.erase(pendingIter);
+
+	IImage * image = pending.task->wait();
+	if(!image)
+	{
+		printError(frame, group, "LoadFrame");
+		image = new SDLImage("DEFAULT", compressed);
+	}
+
+	if(pending.horizontalFlip)
+		image->horizontalFlip();
+	if(pending.verticalFlip)
+		image->verticalFlip();
+	if(pending.player)
+		image->playerColored(pending.player.get());
+
+	for(int i = 1; i < pending.refCount; i++)
+		image->increaseRef();
+
+	images[group][frame] = image;
+
+	if(evictable)
+		CAnimationFrameCache::get().frameLoaded(this, frame, group, image->memoryUsage());
+	return true;
+}
+
+void CAnimation::finishPendingFrames()
+{
+	while(!pendingFrames.empty())
+	{
+		auto key = pendingFrames.begin()->first;
+		finishPendingFrame(key.second, key.first);
+	}
+}
+
 void CAnimation::initFromJson(const JsonNode & config)
 {
 	std::string basepath;
@@ -1447,6 +1704,8 @@ void CAnimation::initFromJson(const JsonNode & config)
 
 void CAnimation::exportBitmaps(const boost::filesystem::path& path) const
 {
+	const_cast<CAnimation *>(this)->finishPendingFrames();
+
 	if(images.empty())
 	{
 		logGlobal->error("Nothing to export, animation is empty");
@@ -1516,6 +1775,7 @@ CAnimation::CAnimation(std::string Name, bool Compressed):
 	name(Name),
 	compressed(Compressed),
 	preloaded(false),
+	evictable(false),
 	defFile(nullptr)
 {
 	size_t dotPos = name.find_last_of('.');
@@ -1538,6 +1798,7 @@ CAnimation::CAnimation():
 	name(""),
 	compressed(false),
 	preloaded(false),
+	evictable(false),
 	defFile(nullptr)
 {
 	init();
@@ -1545,6 +1806,23 @@ CAnimation::CAnimation():
 
 CAnimation::~CAnimation()
 {
+	//worker may still be decoding frame from our def file
+	for(auto & pending : pendingFrames)
+	{
+		pending.second.task->cancel();
+		delete pending.second.task->wait();
+	}
+	pendingFrames.clear();
+
+	if(evictable)
+	{
+		CAnimationFrameCache::get().animationDestroyed(this);
+		for(auto & elem : images)
+			for(auto & _image : elem.second)
+				delete _image.second;
+		images.clear();
+	}
+
 	if(preloaded)
 		unload();
 
@@ -1584,7 +1862,7 @@ void CAnimation::setCustom(std::string filename, size_t frame, size_t group)
 	//FIXME: update image if already loaded
 }
 
-IImage * CAnimation::getImage(size_t frame, size_t group, bool verbose) const
+IImage * CAnimation::findImage(size_t frame, size_t group) const
 {
 	auto groupIter = images.find(group);
 	if (groupIter != images.end())
@@ -1593,11 +1871,52 @@ IImage * CAnimation::getImage(size_t frame, size_t group, bool verbose) const
 		if (imageIter != groupIter->second.end())
 			return imageIter->second;
 	}
-	if (verbose)
-		printError(frame, group, "GetImage");
 	return nullptr;
 }
 
+IImage * CAnimation::getImage(size_t frame, size_t group, bool verbose) const
+{
+	IImage * image = findImage(frame, group);
+
+	if(evictable)
+	{
+		if(image)
+		{
+			CAnimationFrameCache::get().frameAccessed(this, frame, group);
+		}
+		else if(frame < size(group))
+		{
+			// frame was never loaded or has been evicted - (re)loading it does not change observable state of animation
+			auto self = const_cast<CAnimation *>(this);
+			if(!self->finishPendingFrame(frame, group))
+				self->loadFrame(frame, group);
+			image = findImage(frame, group);
+		}
+	}
+	else if(!image && vstd::contains(pendingFrames, std::make_pair(group, frame)))
+	{
+		// frame is still decoded on worker thread, from caller point of view it is already loaded
+		const_cast<CAnimation *>(this)->finishPendingFrame(frame, group);
+		image = findImage(frame, group);
+	}
+
+	if (!image && verbose)
+		printError(frame, group, "GetImage");
+	return image;
+}
+
+void CAnimation::setEvictable()
+{
+	if(evictable)
+		return;
+
+	// already loaded frames are handed over to the cache as well
+	evictable = true;
+	for(auto & elem : images)
+		for(auto & _image : elem.second)
+			CAnimationFrameCache::get().frameLoaded(this, _image.first, elem.first, _image.second->memoryUsage());
+}
+
 void CAnimation::load()
 {
 	for (auto & elem : source)
@@ -1618,10 +1937,34 @@ void CAnimation::preload()
 	if(!preloaded)
 	{
 		preloaded = true;
-		load();
+		//evictable animations load frames on first access
+		if(!evictable)
+			load();
 	}
 }
 
+void CAnimation::preloadAsync()
+{
+	if(!preloaded)
+	{
+		preloaded = true;
+		//evictable animations load frames on first access
+		if(!evictable)
+		{
+			for(auto & elem : source)
+				for(size_t image=0; image < elem.second.size(); image++)
+					loadFrameAsync(image, elem.first);
+		}
+	}
+}
+
+void CAnimation::loadGroupAsync(size_t group)
+{
+	if (vstd::contains(source, group))
+		for (size_t image=0; image < source[group].size(); image++)
+			loadFrameAsync(image, group);
+}
+
 void CAnimation::loadGroup(size_t group)
 {
 	if (vstd::contains(source, group))
@@ -1659,6 +2002,9 @@ void CAnimation::horizontalFlip()
 	for(auto & group : images)
 		for(auto & image : group.second)
 			image.second->horizontalFlip();
+
+	for(auto & pending : pendingFrames)
+		pending.second.horizontalFlip = !pending.second.horizontalFlip;
 }
 
 void CAnimation::verticalFlip()
@@ -1666,6 +2012,9 @@ void CAnimation::verticalFlip()
 	for(auto & group : images)
 		for(auto & image : group.second)
 			image.second->verticalFlip();
+
+	for(auto & pending : pendingFrames)
+		pending.second.verticalFlip = !pending.second.verticalFlip;
 }
 
 void CAnimation::playerColored(PlayerColor player)
@@ -1673,6 +2022,9 @@ void CAnimation::playerColored(PlayerColor player)
 	for(auto & group : images)
 		for(auto & image : group.second)
 			image.second->playerColored(player);
+
+	for(auto & pending : pendingFrames)
+		pending.second.player = player;
 }
 
 void CAnimation::createFlippedGroup(const size_t sourceGroup, const size_t targetGroup)
@@ -1686,6 +2038,128 @@ void CAnimation::createFlippedGroup(const size_t sourceGroup, const size_t targe
 	}
 }
 
+const size_t CAnimationFrameCache::DEFAULT_BUDGET;
+
+CAnimationFrameCache::CAnimationFrameCache(size_t budget)
+	: currentTick(0)
+{
+	stats.hits = 0;
+	stats.misses = 0;
+	stats.evictions = 0;
+	stats.usedMemory = 0;
+	stats.budget = budget ? budget : DEFAULT_BUDGET;
+}
+
+CAnimationFrameCache & CAnimationFrameCache::get()
+{
+	static CAnimationFrameCache instance(static_cast<size_t>(std::max(0.0, settings["video"]["animationCacheSize"].Float()) * 1024 * 1024));
+	return instance;
+}
+
+void CAnimationFrameCache::setBudget(size_t bytes)
+{
+	TLockGuard lock(mx);
+	stats.budget = bytes ? bytes : DEFAULT_BUDGET;
+	evictToBudget();
+}
+
+void CAnimationFrameCache::nextTick()
+{
+	TLockGuard lock(mx);
+	currentTick++;
+	evictToBudget();
+}
+
+void CAnimationFrameCache::frameLoaded(CAnimation * animation, size_t frame, size_t group, size_t memory)
+{
+	TLockGuard lock(mx);
+
+	const TFrameKey key(animation, group, frame);
+	if(vstd::contains(index, key))
+		return;
+
+	FrameInfo info;
+	info.key = key;
+	info.animation = animation;
+	info.memory = memory;
+	info.lastUsedTick = currentTick;
+
+	frames.push_front(info);
+	index[key] = frames.begin();
+	stats.usedMemory += memory;
+	stats.misses++;
+
+	evictToBudget();
+}
+
+void CAnimationFrameCache::frameAccessed(const CAnimation * animation, size_t frame, size_t group)
+{
+	TLockGuard lock(mx);
+
+	auto iter = index.find(TFrameKey(animation, group, frame));
+	if(iter == index.end())
+		return;
+
+	stats.hits++;
+	iter->second->lastUsedTick = currentTick;
+	frames.splice(frames.begin(), frames, iter->second);
+}
+
+void CAnimationFrameCache::frameUnloaded(const CAnimation * animation, size_t frame, size_t group)
+{
+	TLockGuard lock(mx);
+
+	auto iter = index.find(TFrameKey(animation, group, frame));
+	if(iter == index.end())
+		return;
+
+	stats.usedMemory -= iter->second->memory;
+	frames.erase(iter->second);
+	index.erase(iter);
+}
+
+void CAnimationFrameCache::animationDestroyed(const CAnimation * animation)
+{
+	TLockGuard lock(mx);
+
+	auto iter = index.lower_bound(TFrameKey(animation, 0, 0));
+	while(iter != index.end() && std::get<0>(iter->first) == animation)
+	{
+		stats.usedMemory -= iter->second->memory;
+		frames.erase(iter->second);
+		iter = index.erase(iter);
+	}
+}
+
+void CAnimationFrameCache::evictToBudget()
+{
+	ui64 evicted = 0;
+
+	// frames used during current tick may still be referenced by callers
+	while(stats.usedMemory > stats.budget && !frames.empty() && frames.back().lastUsedTick != currentTick)
+	{
+		const FrameInfo & info = frames.back();
+		info.animation->evictFrame(std::get<2>(info.key), std::get<1>(info.key));
+
+		stats.usedMemory -= info.memory;
+		index.erase(info.key);
+		frames.pop_back();
+		evicted++;
+	}
+
+	if(evicted)
+	{
+		stats.evictions += evicted;
+		logAnim->trace("Evicted %d frames, %d KB used of %d KB", evicted, stats.usedMemory / 1024, stats.budget / 1024);
+	}
+}
+
+CAnimationFrameCache::Statistics CAnimationFrameCache::getStatistics() const
+{
+	TLockGuard lock(mx);
+	return stats;
+}
+
 float CFadeAnimation::initialCounter() const
 {
 	if (fadingMode == EMode::OUT)
@@ -47,6 +47,9 @@ public:
 	virtual int width() const=0;
 	virtual int height() const=0;
 
+	//approximate size of image data in memory, in bytes
+	virtual size_t memoryUsage() const = 0;
+
 	//only indexed bitmaps, 16 colors maximum
 	virtual void shiftPalette(int from, int howMany) = 0;
 
@@ -61,6 +64,8 @@ public:
 };
 
 /// Class for handling animation
+class CFrameDecodeTask;
+
 class CAnimation
 {
 private:
@@ -78,14 +83,44 @@ private:
 
 	bool preloaded;
 
+	//if true frames are loaded on first access and may be unloaded by CAnimationFrameCache at any time
+	bool evictable;
+
 	CDefFile * defFile;
 
+	struct PendingFrame
+	{
+		std::shared_ptr<CFrameDecodeTask> task;
+		//number of load requests received while frame was decoded
+		int refCount;
+		//transformations requested while frame was decoded
+		bool horizontalFlip;
+		bool verticalFlip;
+		boost::optional<PlayerColor> player;
+	};
+
+	//frames queued for decoding on worker threads, [group, frame]
+	std::map<std::pair<size_t, size_t>, PendingFrame> pendingFrames;
+
+	//returns loaded image or nullptr, without any side effects
+	IImage * findImage(size_t frame, size_t group) const;
+
 	//loader, will be called by load(), require opened def file for loading from it. Returns true if image is loaded
 	bool loadFrame(size_t frame, size_t group);
 
 	//unloadFrame, returns true if image has been unloaded ( either deleted or decreased refCount)
 	bool unloadFrame(size_t frame, size_t group);
 
+	//deletes frame regardless of its refCount, used by frame cache
+	void evictFrame(size_t frame, size_t group);
+
+	//queues frame for decoding on worker thread, frames not located in def file are loaded immediately
+	void loadFrameAsync(size_t frame, size_t group);
+
+	//waits for frame queued by loadFrameAsync and stores it as loaded. Returns false if frame is not pending
+	bool finishPendingFrame(size_t frame, size_t group);
+	void finishPendingFrames();
+
 	//initialize animation from file
 	void initFromJson(const JsonNode & input);
 	void init();
@@ -97,6 +132,7 @@ private:
 	//TODO: remove after implementing resource manager
 	IImage * getFromExtraDef(std::string filename);
 
+	friend class CAnimationFrameCache;
 public:
 	CAnimation(std::string Name, bool Compressed = false);
 	CAnimation();
@@ -110,8 +146,13 @@ public:
 	void setCustom(std::string filename, size_t frame, size_t group=0);
 
 	//get pointer to image from specific group, nullptr if not found
+	//for evictable animations missing frames are loaded, pointer is valid only until next frame is rendered
 	IImage * getImage(size_t frame, size_t group=0, bool verbose=true) const;
 
+	//frames will be loaded on demand and unloaded when frame cache exceeds its memory budget
+	//images of such animation must not be modified or stored between frames
+	void setEvictable();
+
 	void exportBitmaps(const boost::filesystem::path & path) const;
 
 	//all available frames
@@ -119,6 +160,11 @@ public:
 	void unload();
 	void preload();
 
+	//same as preload() and loadGroup(), but frames are decoded on worker threads
+	//caller only blocks on first access to frame that is not decoded yet
+	void preloadAsync();
+	void loadGroupAsync(size_t group);
+
 	//all frames from group
 	void loadGroup  (size_t group);
 	void unloadGroup(size_t group);
@@ -137,6 +183,58 @@ public:
 	void createFlippedGroup(const size_t sourceGroup, const size_t targetGroup);
 };
 
+/// Tracks frames of evictable animations and unloads least recently used ones when memory budget is exceeded
+/// Frames accessed during current GUI frame are never unloaded, so pointers returned by getImage stay valid until nextTick()
+class CAnimationFrameCache
+{
+public:
+	struct Statistics
+	{
+		ui64 hits;
+		ui64 misses;
+		ui64 evictions;
+		size_t usedMemory;
+		size_t budget;
+	};
+
+private:
+	typedef std::tuple<const CAnimation *, size_t, size_t> TFrameKey; // animation, group, frame
+
+	static const size_t DEFAULT_BUDGET = 256 * 1024 * 1024; // same as default of animationCacheSize setting
+
+	struct FrameInfo
+	{
+		TFrameKey key;
+		CAnimation * animation;
+		size_t memory;
+		ui32 lastUsedTick;
+	};
+
+	std::list<FrameInfo> frames; // most recently used first
+	std::map<TFrameKey, std::list<FrameInfo>::iterator> index;
+	Statistics stats;
+	ui32 currentTick;
+	mutable boost::mutex mx;
+
+	void evictToBudget();
+public:
+	CAnimationFrameCache(size_t budget);
+
+	static CAnimationFrameCache & get();
+
+	/// budget of 0 means default budget
+	void setBudget(size_t bytes);
+	//should be called once per rendered frame
+	void nextTick();
+
+	void frameLoaded(CAnimation * animation, size_t frame, size_t group, size_t memory);
+	void frameAccessed(const CAnimation * animation, size_t frame, size_t group);
+	void frameUnloaded(const CAnimation * animation, size_t frame, size_t group);
+	void animationDestroyed(const CAnimation * animation);
+
+	Statistics getStatistics() const;
+};
+
 const float DEFAULT_DELTA = 0.05f;
 
 class CFadeAnimation
@@ -71,6 +71,7 @@ void CCursorHandler::cursorMove(const int & x, const int & y)
 
 void CCursorHandler::drawWithScreenRestore()
 {
+	drawnArea = Rect();
 	if(!showing) return;
 	int x = xpos, y = ypos;
 	shiftPos(x, y);
@@ -83,11 +84,13 @@ void CCursorHandler::drawWithScreenRestore()
 	{
 		dndObject->moveTo(Point(x - dndObject->pos.w/2, y - dndObject->pos.h/2));
 		dndObject->showAll(screen);
+		drawnArea = dndObject->pos;
 	}
 	else
 	{
 		currentCursor->moveTo(Point(x,y));
 		currentCursor->showAll(screen);
+		drawnArea = currentCursor->pos;
 	}
 }
 
@@ -222,7 +225,13 @@ void CCursorHandler::centerCursor()
 void CCursorHandler::render()
 {
 	drawWithScreenRestore();
-	CSDL_Ext::update(screen);
+
+	//cursor has to be erased from its old position as well
+	GH.invalidate(previousArea);
+	GH.invalidate(drawnArea);
+	GH.updateDirtyRects();
+	previousArea = drawnArea;
+
 	drawRestored();
 }
 
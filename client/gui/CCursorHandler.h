@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include "Geometries.h"
+
 class CAnimImage;
 struct SDL_Surface;
 
@@ -35,6 +37,10 @@ class CCursorHandler final
 
 	bool showing;
 
+	/// Screen area covered by cursor during last frame, it has to be updated when cursor moves away
+	Rect drawnArea;
+	Rect previousArea;
+
 	/// Draw cursor preserving original image below cursor
 	void drawWithScreenRestore();
 	/// Restore original image below cursor
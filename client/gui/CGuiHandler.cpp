@@ -15,6 +15,7 @@
 
 #include "CIntObject.h"
 #include "CCursorHandler.h"
+#include "CAnimation.h"
 
 #include "../CGameInfo.h"
 #include "../../lib/CThreadHelper.h"
@@ -165,6 +166,169 @@ void CGuiHandler::totalRedraw()
 	for(auto & elem : objsToBlit)
 		elem->showAll(screen2);
 	blitAt(screen2,0,0,screen);
+	invalidateAll();
+}
+
+void CGuiHandler::invalidate(const Rect & area)
+{
+	if(!wholeScreenDirty && area.w > 0 && area.h > 0)
+		dirtyRects.push_back(area);
+}
+
+void CGuiHandler::invalidateAll()
+{
+	wholeScreenDirty = true;
+	dirtyRects.clear();
+}
+
+void CGuiHandler::invalidateChanged(const Rect & area)
+{
+	//area is compared in bands of rows, each band gives one rect that spans its changed columns
+	const int bandHeight = 16;
+	const int columnWidth = 32;
+
+	if(wholeScreenDirty)
+		return;
+
+	if(uploadedScreen.size() != static_cast<size_t>(screen->pitch) * screen->h)
+	{
+		invalidateAll(); //screen texture contents are not known yet
+		return;
+	}
+
+	const Rect clipped = area & Rect(screen);
+	if(clipped.w <= 0 || clipped.h <= 0)
+		return;
+
+	const int bpp = screen->format->BytesPerPixel;
+	const int columns = (clipped.w + columnWidth - 1) / columnWidth;
+	const ui8 * pixels = static_cast<const ui8 *>(screen->pixels);
+
+	auto columnChanged = [&](int top, int bottom, int column) -> bool
+	{
+		const int left = clipped.x + column * columnWidth;
+		const size_t length = std::min(columnWidth, clipped.x + clipped.w - left) * bpp;
+		for(int y = top; y < bottom; y++)
+		{
+			const size_t offset = static_cast<size_t>(y) * screen->pitch + left * bpp;
+			if(memcmp(pixels + offset, uploadedScreen.data() + offset, length) != 0)
+				return true;
+		}
+		return false;
+	};
+
+	for(int top = clipped.y; top < clipped.y + clipped.h; top += bandHeight)
+	{
+		const int bottom = std::min(top + bandHeight, clipped.y + clipped.h);
+
+		int first = 0;
+		while(first < columns && !columnChanged(top, bottom, first))
+			first++;
+		if(first == columns)
+			continue;
+
+		int last = columns - 1;
+		while(last > first && !columnChanged(top, bottom, last))
+			last--;
+
+		const int left = clipped.x + first * columnWidth;
+		const int right = std::min(clipped.x + (last + 1) * columnWidth, clipped.x + clipped.w);
+		invalidate(Rect(left, top, right - left, bottom - top));
+	}
+}
+
+void CGuiHandler::storeUploaded(const Rect & area)
+{
+	const int bpp = screen->format->BytesPerPixel;
+	const ui8 * pixels = static_cast<const ui8 *>(screen->pixels);
+
+	for(int y = area.y; y < area.y + area.h; y++)
+	{
+		const size_t offset = static_cast<size_t>(y) * screen->pitch + area.x * bpp;
+		memcpy(uploadedScreen.data() + offset, pixels + offset, area.w * bpp);
+	}
+}
+
+void CGuiHandler::mergeDirtyRects()
+{
+	//too fragmented updates are cheaper to upload as single area
+	const size_t maxRects = 16;
+
+	const Rect screenRect(screen);
+	const ui64 screenArea = static_cast<ui64>(screenRect.w) * screenRect.h;
+
+	std::vector<Rect> merged;
+	ui64 totalArea = 0;
+
+	for(const Rect & area : dirtyRects)
+	{
+		Rect current = area & screenRect;
+		if(current.w <= 0 || current.h <= 0)
+			continue;
+
+		//union is used whenever it is not much larger than both rects together
+		bool changed = true;
+		while(changed)
+		{
+			changed = false;
+			for(auto iter = merged.begin(); iter != merged.end(); ++iter)
+			{
+				const Rect joined = current | *iter;
+				const ui64 joinedArea = static_cast<ui64>(joined.w) * joined.h;
+				const ui64 separateArea = static_cast<ui64>(current.w) * current.h + static_cast<ui64>(iter->w) * iter->h;
+				if(joinedArea <= separateArea + separateArea / 4)
+				{
+					current = joined;
+					merged.erase(iter);
+					changed = true;
+					break;
+				}
+			}
+		}
+		merged.push_back(current);
+	}
+
+	for(const Rect & area : merged)
+		totalArea += static_cast<ui64>(area.w) * area.h;
+
+	if(merged.size() > maxRects || totalArea * 2 > screenArea)
+	{
+		invalidateAll();
+		return;
+	}
+	dirtyRects = merged;
+}
+
+void CGuiHandler::updateDirtyRects()
+{
+	const size_t screenSize = static_cast<size_t>(screen->pitch) * screen->h;
+	if(uploadedScreen.size() != screenSize)
+		invalidateAll();
+
+	if(!wholeScreenDirty)
+		mergeDirtyRects();
+
+	if(wholeScreenDirty)
+	{
+		CSDL_Ext::update(screen);
+		pixelsRedrawn = static_cast<ui64>(screen->w) * screen->h;
+
+		const ui8 * pixels = static_cast<const ui8 *>(screen->pixels);
+		uploadedScreen.assign(pixels, pixels + screenSize);
+	}
+	else
+	{
+		pixelsRedrawn = 0;
+		for(const Rect & area : dirtyRects)
+		{
+			CSDL_Ext::update(screen, area);
+			storeUploaded(area);
+			pixelsRedrawn += static_cast<ui64>(area.w) * area.h;
+		}
+	}
+
+	wholeScreenDirty = false;
+	dirtyRects.clear();
 }
 
 void CGuiHandler::updateTime()
@@ -397,7 +561,18 @@ void CGuiHandler::simpleRedraw()
 {
 	//update only top interface and draw background
 	if(objsToBlit.size() > 1)
-		blitAt(screen2,0,0,screen); //blit background
+	{
+		//screen outside of active window is not touched by show(), background is needed only below it
+		auto top = dynamic_cast<CIntObject *>(objsToBlit.back());
+		if(top)
+		{
+			Rect area = top->pos & Rect(screen2);
+			if(area.w > 0 && area.h > 0)
+				CSDL_Ext::blitSurface(screen2, &area, screen, &area);
+		}
+		else
+			blitAt(screen2,0,0,screen); //blit background
+	}
 	if(!objsToBlit.empty())
 		objsToBlit.back()->show(screen); //blit active interface/window
 }
@@ -450,6 +625,13 @@ void CGuiHandler::renderFrame()
 		if(nullptr != curInt)
 			curInt->update();
 
+		//active interface is shown on every frame, only pixels that differ from screen texture are uploaded
+		auto top = dynamic_cast<CIntObject *>(topInt());
+		if(top)
+			invalidateChanged(top->pos);
+		else
+			invalidateAll();
+
 		if (settings["general"]["showfps"].Bool())
 			drawFPSCounter();
 
@@ -459,6 +641,8 @@ void CGuiHandler::renderFrame()
 		SDL_RenderCopy(mainRenderer, screenTexture, nullptr, nullptr);
 
 		SDL_RenderPresent(mainRenderer);
+
+		CAnimationFrameCache::get().nextTick();
 	}
 
 	mainFPSmng->framerateDelay(); // holds a constant FPS
@@ -466,7 +650,7 @@ void CGuiHandler::renderFrame()
 
 
 CGuiHandler::CGuiHandler()
-	: lastClick(-500, -500),lastClickTime(0), defActionsDef(0), captureChildren(false)
+	: wholeScreenDirty(true), pixelsRedrawn(0), lastClick(-500, -500),lastClickTime(0), defActionsDef(0), captureChildren(false)
 {
 	continueEventHandling = true;
 	curInt = nullptr;
@@ -494,11 +678,15 @@ void CGuiHandler::breakEventHandling()
 void CGuiHandler::drawFPSCounter()
 {
 	const static SDL_Color yellow = {255, 255, 0, 0};
-	static SDL_Rect overlay = { 0, 0, 64, 32};
+	static SDL_Rect overlay = { 0, 0, 64, 48};
 	Uint32 black = SDL_MapRGB(screen->format, 10, 10, 10);
 	SDL_FillRect(screen, &overlay, black);
 	std::string fps = boost::lexical_cast<std::string>(mainFPSmng->fps);
 	graphics->fonts[FONT_BIG]->renderTextLeft(screen, fps, yellow, Point(10, 10));
+	//thousands of pixels uploaded to screen during previous frame
+	std::string pixels = boost::lexical_cast<std::string>(pixelsRedrawn / 1000) + "k px";
+	graphics->fonts[FONT_SMALL]->renderTextLeft(screen, pixels, yellow, Point(10, 32));
+	invalidate(overlay);
 }
 
 SDL_Keycode CGuiHandler::arrowToNum(SDL_Keycode key)
@@ -64,8 +64,19 @@ private:
 	               textInterested;
 
 
+	//areas of screen changed since last frame, only they are uploaded to screen texture
+	std::vector<Rect> dirtyRects;
+	bool wholeScreenDirty;
+	//number of pixels uploaded during last frame, shown next to FPS counter
+	ui64 pixelsRedrawn;
+	//copy of screen as it was uploaded to screen texture, used to find pixels changed by active interface
+	std::vector<ui8> uploadedScreen;
+
 	void handleMouseButtonClick(CIntObjectList & interestedObjs, EIntObjMouseBtnType btn, bool isPressed);
 	void processLists(const ui16 activityFlag, std::function<void (std::list<CIntObject*> *)> cb);
+	void mergeDirtyRects();
+	void invalidateChanged(const Rect & area); //marks parts of area that differ from screen texture
+	void storeUploaded(const Rect & area);
 public:
 	void handleElementActivate(CIntObject * elem, ui16 activityFlag);
 	void handleElementDeActivate(CIntObject * elem, ui16 activityFlag);
@@ -92,6 +103,11 @@ public:
 	void totalRedraw(); //forces total redraw (using showAll), sets a flag, method gets called at the end of the rendering
 	void simpleRedraw(); //update only top interface and draw background from buffer, sets a flag, method gets called at the end of the rendering
 
+	void invalidate(const Rect & area); //marks area of screen as changed, it will be updated at the end of the frame
+	void invalidateAll(); //whole screen will be updated at the end of the frame
+	void updateDirtyRects(); //uploads all changed areas of screen to screen texture
+	ui64 getPixelsRedrawn() const { return pixelsRedrawn; }
+
 	void popInt(IShowActivatable *top); //removes given interface from the top and activates next
 	void popIntTotally(IShowActivatable *top); //deactivates, deletes, removes given interface from the top and activates next
 	void pushInt(IShowActivatable *newInt); //deactivate old top interface, activates this one and pushes to the top
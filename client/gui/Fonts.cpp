@@ -18,6 +18,10 @@
 #include "../../lib/filesystem/Filesystem.h"
 #include "../../lib/CGeneralTextHandler.h"
 
+// number of distinct strings remembered by each font
+static const size_t TEXT_RUNS_CACHE_SIZE = 512;
+static const size_t RENDERED_TEXT_CACHE_SIZE = 256;
+
 size_t IFont::getStringWidth(const std::string & data) const
 {
 	size_t width = 0;
@@ -107,9 +111,32 @@ std::array<CBitmapFont::BitmapChar, CBitmapFont::totalChars> CBitmapFont::loadCh
 CBitmapFont::CBitmapFont(const std::string & filename):
     data(CResourceHandler::get()->load(ResourceID("data/" + filename, EResType::BMP_FONT))->readAll()),
     chars(loadChars()),
-    height(data.first.get()[5])
+    height(data.first.get()[5]),
+    runs(TEXT_RUNS_CACHE_SIZE)
 {}
 
+const IFont::TextRun & CBitmapFont::getTextRun(const std::string & data) const
+{
+	if(const TextRun * cached = runs.find(data))
+		return *cached;
+
+	TextRun run;
+	run.width = 0;
+
+	for(size_t i=0; i<data.size(); i += Unicode::getCharacterSize(data[i]))
+	{
+		std::string localChar = Unicode::fromUnicode(data.substr(i, Unicode::getCharacterSize(data[i])));
+
+		if (localChar.size() == 1)
+		{
+			const BitmapChar & ch = chars[ui8(localChar[0])];
+			run.glyphs.push_back(ui8(localChar[0]));
+			run.width += ch.leftOffset + ch.width + ch.rightOffset;
+		}
+	}
+	return runs.insert(data, std::move(run));
+}
+
 size_t CBitmapFont::getLineHeight() const
 {
 	return height;
@@ -127,6 +154,11 @@ size_t CBitmapFont::getGlyphWidth(const char * data) const
 	return 0;
 }
 
+size_t CBitmapFont::getStringWidth(const std::string & data) const
+{
+	return getTextRun(data).width;
+}
+
 void CBitmapFont::renderCharacter(SDL_Surface * surface, const BitmapChar & character, const SDL_Color & color, int &posX, int &posY) const
 {
 	Rect clipRect;
@@ -191,15 +223,13 @@ void CBitmapFont::renderText(SDL_Surface * surface, const std::string & data, co
 	//assert(data[0] != '{');
 	//assert(data[data.size()-1] != '}');
 
+	const TextRun & run = getTextRun(data);
+
 	SDL_LockSurface(surface);
 
-	for(size_t i=0; i<data.size(); i += Unicode::getCharacterSize(data[i]))
-	{
-		std::string localChar = Unicode::fromUnicode(data.substr(i, Unicode::getCharacterSize(data[i])));
+	for(ui16 glyph : run.glyphs)
+		renderCharacter(surface, chars[glyph], color, posX, posY);
 
-		if (localChar.size() == 1)
-			renderCharacter(surface, chars[ui8(localChar[0])], color, posX, posY);
-	}
 	SDL_UnlockSurface(surface);
 }
 
@@ -236,7 +266,9 @@ int CTrueTypeFont::getFontStyle(const JsonNode &config)
 CTrueTypeFont::CTrueTypeFont(const JsonNode & fontConfig):
     data(loadData(fontConfig)),
     font(loadFont(fontConfig), TTF_CloseFont),
-    blended(fontConfig["blend"].Bool())
+    blended(fontConfig["blend"].Bool()),
+    renderedRuns(RENDERED_TEXT_CACHE_SIZE),
+    stringWidths(TEXT_RUNS_CACHE_SIZE)
 {
 	assert(font);
 
@@ -260,9 +292,30 @@ size_t CTrueTypeFont::getGlyphWidth(const char *data) const
 
 size_t CTrueTypeFont::getStringWidth(const std::string & data) const
 {
+	if(const size_t * cached = stringWidths.find(data))
+		return *cached;
+
 	int width;
 	TTF_SizeUTF8(font.get(), data.c_str(), &width, nullptr);
-	return width;
+	return stringWidths.insert(data, width);
+}
+
+SDL_Surface * CTrueTypeFont::getRenderedText(const std::string & data, const SDL_Color & color) const
+{
+	const auto key = std::make_pair(data, CSDL_Ext::colorToUint32(&color));
+
+	if(const auto * cached = renderedRuns.find(key))
+		return cached->get();
+
+	SDL_Surface * rendered;
+	if (blended)
+		rendered = TTF_RenderUTF8_Blended(font.get(), data.c_str(), color);
+	else
+		rendered = TTF_RenderUTF8_Solid(font.get(), data.c_str(), color);
+
+	assert(rendered);
+
+	return renderedRuns.insert(key, std::shared_ptr<SDL_Surface>(rendered, SDL_FreeSurface)).get();
 }
 
 void CTrueTypeFont::renderText(SDL_Surface * surface, const std::string & data, const SDL_Color & color, const Point & pos) const
@@ -275,17 +328,12 @@ void CTrueTypeFont::renderText(SDL_Surface * surface, const std::string & data,
 
 	if (!data.empty())
 	{
-		SDL_Surface * rendered;
-		if (blended)
-			rendered = TTF_RenderUTF8_Blended(font.get(), data.c_str(), color);
-		else
-			rendered = TTF_RenderUTF8_Solid(font.get(), data.c_str(), color);
-
-		assert(rendered);
+		SDL_Surface * rendered = getRenderedText(data, color);
+		if(!rendered)
+			return;
 
 		Rect rect(pos.x, pos.y, rendered->w, rendered->h);
 		SDL_BlitSurface(rendered, nullptr, surface, &rect);
-		SDL_FreeSurface(rendered);
 	}
 }
 
@@ -345,22 +393,49 @@ void CBitmapHanFont::renderCharacter(SDL_Surface * surface, int characterIndex,
 	posX += size + 1;
 }
 
-void CBitmapHanFont::renderText(SDL_Surface * surface, const std::string & data, const SDL_Color & color, const Point & pos) const
+const IFont::TextRun & CBitmapHanFont::getTextRun(const std::string & data) const
 {
-	int posX = pos.x;
-	int posY = pos.y;
+	if(const TextRun * cached = runs.find(data))
+		return *cached;
 
-	SDL_LockSurface(surface);
+	TextRun run;
+	run.width = 0;
 
 	for(size_t i=0; i<data.size(); i += Unicode::getCharacterSize(data[i]))
 	{
 		std::string localChar = Unicode::fromUnicode(data.substr(i, Unicode::getCharacterSize(data[i])));
 
 		if (localChar.size() == 1)
-			fallback->renderCharacter(surface, fallback->chars[ui8(localChar[0])], color, posX, posY);
+		{
+			const CBitmapFont::BitmapChar & ch = fallback->chars[ui8(localChar[0])];
+			run.glyphs.push_back(ui8(localChar[0]));
+			run.width += ch.leftOffset + ch.width + ch.rightOffset;
+		}
 
 		if (localChar.size() == 2)
-			renderCharacter(surface, getCharacterIndex(localChar[0], localChar[1]), color, posX, posY);
+		{
+			run.glyphs.push_back((ui8(localChar[0]) << 8) | ui8(localChar[1]));
+			run.width += size + 1;
+		}
+	}
+	return runs.insert(data, std::move(run));
+}
+
+void CBitmapHanFont::renderText(SDL_Surface * surface, const std::string & data, const SDL_Color & color, const Point & pos) const
+{
+	int posX = pos.x;
+	int posY = pos.y;
+
+	const TextRun & run = getTextRun(data);
+
+	SDL_LockSurface(surface);
+
+	for(ui16 glyph : run.glyphs)
+	{
+		if (glyph < 0x100)
+			fallback->renderCharacter(surface, fallback->chars[glyph], color, posX, posY);
+		else
+			renderCharacter(surface, getCharacterIndex(glyph >> 8, glyph & 0xff), color, posX, posY);
 	}
 	SDL_UnlockSurface(surface);
 }
@@ -368,7 +443,8 @@ void CBitmapHanFont::renderText(SDL_Surface * surface, const std::string & data,
 CBitmapHanFont::CBitmapHanFont(const JsonNode &config):
     fallback(new CBitmapFont(config["fallback"].String())),
     data(CResourceHandler::get()->load(ResourceID("data/" + config["name"].String(), EResType::OTHER))->readAll()),
-    size(config["size"].Float())
+    size(config["size"].Float()),
+    runs(TEXT_RUNS_CACHE_SIZE)
 {
 	// basic tests to make sure that fonts are OK
 	// 1) fonts must contain 190 "sections", 126 symbols each.
@@ -394,3 +470,8 @@ size_t CBitmapHanFont::getGlyphWidth(const char * data) const
 
 	return 0;
 }
+
+size_t CBitmapHanFont::getStringWidth(const std::string & data) const
+{
+	return getTextRun(data).width;
+}
@@ -20,9 +20,57 @@ typedef struct _TTF_Font TTF_Font;
 class CBitmapFont;
 class CBitmapHanFont;
 
+/// Small least-recently-used cache for data generated from text, e.g. converted or rendered strings
+/// Fonts are used only from GUI thread (under pim lock) so no locking is done here
+template<typename Key, typename Value>
+class CTextCache
+{
+	typedef std::list<std::pair<Key, Value>> TEntries;
+
+	const size_t capacity;
+	TEntries entries; //most recently used entries are at front
+	std::map<Key, typename TEntries::iterator> index;
+
+public:
+	CTextCache(size_t Capacity):
+		capacity(Capacity)
+	{}
+
+	/// returns cached value or nullptr, marks entry as recently used
+	const Value * find(const Key & key)
+	{
+		auto iter = index.find(key);
+		if(iter == index.end())
+			return nullptr;
+
+		entries.splice(entries.begin(), entries, iter->second);
+		return &iter->second->second;
+	}
+
+	/// stores new value, least recently used entry is dropped if cache is full
+	const Value & insert(const Key & key, Value value)
+	{
+		if(entries.size() >= capacity)
+		{
+			index.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(key, std::move(value));
+		index[key] = entries.begin();
+		return entries.front().second;
+	}
+};
+
 class IFont
 {
 protected:
+	/// Text converted to glyphs of font: single-byte characters or two-byte codes (first byte in high bits)
+	struct TextRun
+	{
+		std::vector<ui16> glyphs;
+		size_t width;
+	};
+
 	/// Internal function to render font, see renderTextLeft
 	virtual void renderText(SDL_Surface * surface, const std::string & data, const SDL_Color & color, const Point & pos) const = 0;
 
@@ -75,7 +123,11 @@ class CBitmapFont : public IFont
 	const std::array<BitmapChar, totalChars> chars;
 	const ui8 height;
 
+	/// strings converted to local charset, conversion is done once per string instead of every time it is drawn
+	mutable CTextCache<std::string, TextRun> runs;
+
 	std::array<BitmapChar, totalChars> loadChars() const;
+	const TextRun & getTextRun(const std::string & data) const;
 
 	void renderCharacter(SDL_Surface * surface, const BitmapChar & character, const SDL_Color & color, int &posX, int &posY) const;
 
@@ -85,6 +137,7 @@ public:
 
 	size_t getLineHeight() const override;
 	size_t getGlyphWidth(const char * data) const override;
+	size_t getStringWidth(const std::string & data) const override;
 
 	friend class CBitmapHanFont;
 };
@@ -99,8 +152,11 @@ class CBitmapHanFont : public IFont
 	// size of the font. Not available in file but needed for proper rendering
 	const size_t size;
 
+	mutable CTextCache<std::string, TextRun> runs;
+
 	size_t getCharacterDataOffset(size_t index) const;
 	size_t getCharacterIndex(ui8 first, ui8 second) const;
+	const TextRun & getTextRun(const std::string & data) const;
 
 	void renderCharacter(SDL_Surface * surface, int characterIndex, const SDL_Color & color, int &posX, int &posY) const;
 	void renderText(SDL_Surface * surface, const std::string & data, const SDL_Color & color, const Point & pos) const override;
@@ -109,6 +165,7 @@ public:
 
 	size_t getLineHeight() const override;
 	size_t getGlyphWidth(const char * data) const override;
+	size_t getStringWidth(const std::string & data) const override;
 };
 
 class CTrueTypeFont : public IFont
@@ -118,6 +175,12 @@ class CTrueTypeFont : public IFont
 	const std::unique_ptr<TTF_Font, void (*)(TTF_Font*)> font;
 	const bool blended;
 
+	/// rendered strings, keyed by text and color, since same labels are usually drawn on every frame
+	mutable CTextCache<std::pair<std::string, ui32>, std::shared_ptr<SDL_Surface>> renderedRuns;
+	mutable CTextCache<std::string, size_t> stringWidths;
+
+	SDL_Surface * getRenderedText(const std::string & data, const SDL_Color & color) const;
+
 	std::pair<std::unique_ptr<ui8[]>, ui64> loadData(const JsonNode & config);
 	TTF_Font * loadFont(const JsonNode & config);
 	int getFontStyle(const JsonNode & config);
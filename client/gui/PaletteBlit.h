@@ -0,0 +1,140 @@
+/*
+ * PaletteBlit.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+// row kernels for blitting paletted images with per-color alpha into 32 bpp surfaces
+// free of SDL dependencies, so they can be tested on their own
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define VCMI_SSE2_BLITS
+#  include <emmintrin.h>
+#endif
+
+namespace PaletteBlit
+{
+	/// byte offsets of channels in 32 bpp pixel, must match Channels::px<4>
+	template<int R, int G, int B, int A>
+	struct Layout
+	{
+		static const int r = R;
+		static const int g = G;
+		static const int b = B;
+		static const int a = A;
+	};
+
+	/// 32 bpp pixel with full alpha; TColor is SDL_Color or any struct with r, g, b and a fields
+	template<typename TLayout, typename TColor>
+	inline ui32 makeOpaquePixel(const TColor & color)
+	{
+		ui8 bytes[4];
+		bytes[TLayout::r] = color.r;
+		bytes[TLayout::g] = color.g;
+		bytes[TLayout::b] = color.b;
+		bytes[TLayout::a] = 255;
+
+		ui32 pixel;
+		memcpy(&pixel, bytes, sizeof(pixel));
+		return pixel;
+	}
+
+	/// reference implementation, same as ColorPutter<4, 1>::PutColorAlphaSwitch
+	template<typename TLayout, typename TColor>
+	inline void blendPixel(ui8 * dst, const TColor & color)
+	{
+		switch(color.a)
+		{
+		case 0:
+			return;
+		case 255:
+			dst[TLayout::r] = color.r;
+			dst[TLayout::g] = color.g;
+			dst[TLayout::b] = color.b;
+			break;
+		case 128:
+			dst[TLayout::r] = ((ui16)color.r + dst[TLayout::r]) >> 1;
+			dst[TLayout::g] = ((ui16)color.g + dst[TLayout::g]) >> 1;
+			dst[TLayout::b] = ((ui16)color.b + dst[TLayout::b]) >> 1;
+			break;
+		default:
+			// unsigned wrap-around of the difference is part of the original formula
+			dst[TLayout::r] = ((((ui32)color.r - (ui32)dst[TLayout::r]) * (ui32)color.a) >> 8) + (ui32)dst[TLayout::r];
+			dst[TLayout::g] = ((((ui32)color.g - (ui32)dst[TLayout::g]) * (ui32)color.a) >> 8) + (ui32)dst[TLayout::g];
+			dst[TLayout::b] = ((((ui32)color.b - (ui32)dst[TLayout::b]) * (ui32)color.a) >> 8) + (ui32)dst[TLayout::b];
+			break;
+		}
+		dst[TLayout::a] = 255;
+	}
+
+	/// reference implementation of blitRow(), one pixel at time
+	template<typename TLayout, typename TColor>
+	inline void blitRowScalar(const ui8 * src, ui8 * dst, int count, const TColor * colors)
+	{
+		for(int x = 0; x < count; x++)
+			blendPixel<TLayout>(dst + x * 4, colors[src[x]]);
+	}
+
+	/// blits one row of 8 bpp pixels to 32 bpp surface, four pixels at once
+	/// produces exactly the same result as blitRowScalar():
+	/// low byte of ((src - dst) * alpha) >> 8 does not depend on higher bits of the product, so 16-bit lanes are enough,
+	/// and the "alpha == 128" shortcut of the scalar code is equal to the generic formula
+	template<typename TLayout, typename TColor>
+	inline void blitRow(const ui8 * src, ui8 * dst, int count, const TColor * colors)
+	{
+		int x = 0;
+#ifdef VCMI_SSE2_BLITS
+		const __m128i alphaMask = _mm_set1_epi32(makeOpaquePixel<TLayout>(TColor())); // black pixel with full alpha
+		const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+		const __m128i zero = _mm_setzero_si128();
+
+		for(; x + 4 <= count; x += 4)
+		{
+			const TColor & c0 = colors[src[x]];
+			const TColor & c1 = colors[src[x + 1]];
+			const TColor & c2 = colors[src[x + 2]];
+			const TColor & c3 = colors[src[x + 3]];
+
+			if((c0.a | c1.a | c2.a | c3.a) == 0)
+				continue;
+
+			const __m128i source = _mm_set_epi32(makeOpaquePixel<TLayout>(c3), makeOpaquePixel<TLayout>(c2), makeOpaquePixel<TLayout>(c1), makeOpaquePixel<TLayout>(c0));
+			ui8 * target = dst + x * 4;
+
+			if((c0.a & c1.a & c2.a & c3.a) == 255)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(target), source);
+				continue;
+			}
+
+			const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target));
+			const __m128i alphaLow = _mm_set_epi16(c1.a, c1.a, c1.a, c1.a, c0.a, c0.a, c0.a, c0.a);
+			const __m128i alphaHigh = _mm_set_epi16(c3.a, c3.a, c3.a, c3.a, c2.a, c2.a, c2.a, c2.a);
+
+			const __m128i destLow = _mm_unpacklo_epi8(dest, zero);
+			const __m128i destHigh = _mm_unpackhi_epi8(dest, zero);
+			const __m128i diffLow = _mm_sub_epi16(_mm_unpacklo_epi8(source, zero), destLow);
+			const __m128i diffHigh = _mm_sub_epi16(_mm_unpackhi_epi8(source, zero), destHigh);
+
+			const __m128i blendLow = _mm_and_si128(_mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(diffLow, alphaLow), 8), destLow), lowByteMask);
+			const __m128i blendHigh = _mm_and_si128(_mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(diffHigh, alphaHigh), 8), destHigh), lowByteMask);
+			const __m128i blended = _mm_or_si128(_mm_packus_epi16(blendLow, blendHigh), alphaMask);
+
+			// alpha 255 - source pixel, alpha 0 - destination pixel, blended pixel otherwise
+			const __m128i alpha = _mm_set_epi32(c3.a, c2.a, c1.a, c0.a);
+			const __m128i opaque = _mm_cmpeq_epi32(alpha, _mm_set1_epi32(255));
+			const __m128i transparent = _mm_cmpeq_epi32(alpha, zero);
+
+			__m128i result = _mm_or_si128(_mm_and_si128(opaque, source), _mm_andnot_si128(opaque, blended));
+			result = _mm_or_si128(_mm_and_si128(transparent, dest), _mm_andnot_si128(transparent, result));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(target), result);
+		}
+#endif
+		blitRowScalar<TLayout>(src + x, dst + x * 4, count - x, colors);
+	}
+}
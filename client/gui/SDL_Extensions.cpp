@@ -10,6 +10,7 @@
 #include "StdInc.h"
 #include "SDL_Extensions.h"
 #include "SDL_Pixels.h"
+#include "PaletteBlit.h"
 
 #include "../CGameInfo.h"
 #include "../CMessage.h"
@@ -196,6 +197,13 @@ void CSDL_Ext::alphaTransform(SDL_Surface *src)
 	SDL_SetColorKey(src, SDL_TRUE, 0);
 }
 
+/// layout of 32 bpp surfaces, same as Channels::px<4>
+#if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
+typedef PaletteBlit::Layout<1, 2, 3, 0> TSurfaceLayout32;
+#else
+typedef PaletteBlit::Layout<2, 1, 0, 3> TSurfaceLayout32;
+#endif
+
 template<int bpp>
 int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const SDL_Rect * srcRect, SDL_Surface * dst, SDL_Rect * dstRect)
 {
@@ -303,6 +311,12 @@ int CSDL_Ext::blit8bppAlphaTo24bppT(const SDL_Surface * src, const SDL_Rect * sr
 
 			for(int y=h; y; y--, colory+=src->pitch, py+=dst->pitch)
 			{
+				if(bpp == 4)
+				{
+					PaletteBlit::blitRow<TSurfaceLayout32>(colory, py, w, colors);
+					continue;
+				}
+
 				Uint8 *color = colory;
 				Uint8 *p = py;
 
@@ -351,6 +365,20 @@ void CSDL_Ext::update(SDL_Surface * what)
 	if(0 !=SDL_UpdateTexture(screenTexture, nullptr, what->pixels, what->pitch))
 		logGlobal->error("%s SDL_UpdateTexture %s", __FUNCTION__, SDL_GetError());
 }
+
+void CSDL_Ext::update(SDL_Surface * what, const Rect & area)
+{
+	if(!what)
+		return;
+
+	const Rect clipped = area & Rect(what);
+	if(clipped.w <= 0 || clipped.h <= 0)
+		return;
+
+	const ui8 * pixels = static_cast<const ui8 *>(what->pixels) + clipped.y * what->pitch + clipped.x * what->format->BytesPerPixel;
+	if(0 !=SDL_UpdateTexture(screenTexture, &clipped, pixels, what->pitch))
+		logGlobal->error("%s SDL_UpdateTexture %s", __FUNCTION__, SDL_GetError());
+}
 void CSDL_Ext::drawBorder(SDL_Surface * sur, int x, int y, int w, int h, const int3 &color)
 {
 	for(int i = 0; i < w; i++)
@@ -528,11 +556,11 @@ void CSDL_Ext::applyEffectBpp( SDL_Surface * surf, const SDL_Rect * rect, int mo
 			const int sepiaDepth = 20;
 			const int sepiaIntensity = 30;
 
-			for(int xp = rect->x; xp < rect->x + rect->w; ++xp)
+			for(int yp = rect->y; yp < rect->y + rect->h; ++yp)
 			{
-				for(int yp = rect->y; yp < rect->y + rect->h; ++yp)
+				Uint8 * pixel = (ui8*)surf->pixels + yp * surf->pitch + rect->x * bpp;
+				for(int xp = rect->x; xp < rect->x + rect->w; ++xp, pixel += bpp)
 				{
-					Uint8 * pixel = (ui8*)surf->pixels + yp * surf->pitch + xp * surf->format->BytesPerPixel;
 					int r = Channels::px<bpp>::r.get(pixel);
 					int g = Channels::px<bpp>::g.get(pixel);
 					int b = Channels::px<bpp>::b.get(pixel);
@@ -561,12 +589,11 @@ void CSDL_Ext::applyEffectBpp( SDL_Surface * surf, const SDL_Rect * rect, int mo
 		break;
 	case 1: //grayscale
 		{
-			for(int xp = rect->x; xp < rect->x + rect->w; ++xp)
+			for(int yp = rect->y; yp < rect->y + rect->h; ++yp)
 			{
-				for(int yp = rect->y; yp < rect->y + rect->h; ++yp)
+				Uint8 * pixel = (ui8*)surf->pixels + yp * surf->pitch + rect->x * bpp;
+				for(int xp = rect->x; xp < rect->x + rect->w; ++xp, pixel += bpp)
 				{
-					Uint8 * pixel = (ui8*)surf->pixels + yp * surf->pitch + xp * surf->format->BytesPerPixel;
-
 					int r = Channels::px<bpp>::r.get(pixel);
 					int g = Channels::px<bpp>::g.get(pixel);
 					int b = Channels::px<bpp>::b.get(pixel);
@@ -602,20 +629,21 @@ void scaleSurfaceFastInternal(SDL_Surface *surf, SDL_Surface *ret)
 	const float factorX = float(surf->w) / float(ret->w),
 				factorY = float(surf->h) / float(ret->h);
 
+	// source column is the same for every row
+	std::vector<int> srcOffsets(ret->w);
+	for(int x = 0; x < ret->w; x++)
+		srcOffsets[x] = int(floor(factorX * x)) * bpp;
+
 	for(int y = 0; y < ret->h; y++)
 	{
-		for(int x = 0; x < ret->w; x++)
-		{
-			//coordinates we want to calculate
-			int origX = floor(factorX * x),
-				origY = floor(factorY * y);
+		//coordinates we want to calculate
+		int origY = floor(factorY * y);
 
-			// Get pointers to source pixels
-			Uint8 *srcPtr = (Uint8*)surf->pixels + origY * surf->pitch + origX * bpp;
-			Uint8 *destPtr = (Uint8*)ret->pixels + y * ret->pitch + x * bpp;
+		const Uint8 *srcRow = (Uint8*)surf->pixels + origY * surf->pitch;
+		Uint8 *destPtr = (Uint8*)ret->pixels + y * ret->pitch;
 
-			memcpy(destPtr, srcPtr, bpp);
-		}
+		for(int x = 0; x < ret->w; x++, destPtr += bpp)
+			memcpy(destPtr, srcRow + srcOffsets[x], bpp);
 	}
 }
 
@@ -646,30 +674,47 @@ void scaleSurfaceInternal(SDL_Surface *surf, SDL_Surface *ret)
 	const float factorX = float(surf->w - 1) / float(ret->w),
 				factorY = float(surf->h - 1) / float(ret->h);
 
+	// horizontal coordinates and distances are the same for every row
+	struct ColumnInfo
+	{
+		int offset; // offset of left source pixel in row [in bytes]
+		float distLeft, distRight;
+	};
+
+	std::vector<ColumnInfo> columns(ret->w);
+	for(int x = 0; x < ret->w; x++)
+	{
+		float origX = factorX * x;
+		float x1 = floor(origX), x2 = floor(origX+1);
+		columns[x].offset = int(x1) * bpp;
+		columns[x].distLeft = origX - x1;
+		columns[x].distRight = x2 - origX;
+	}
+
 	for(int y = 0; y < ret->h; y++)
 	{
+		//coordinates we want to interpolate
+		float origY = factorY * y;
+		float y1 = floor(origY), y2 = floor(origY+1);
+		const Uint8 *srcRow = (Uint8*)surf->pixels + int(y1) * surf->pitch;
+
 		for(int x = 0; x < ret->w; x++)
 		{
-			//coordinates we want to interpolate
-			float origX = factorX * x,
-				  origY = factorY * y;
-
-			float x1 = floor(origX), x2 = floor(origX+1),
-				  y1 = floor(origY), y2 = floor(origY+1);
+			const ColumnInfo & column = columns[x];
 			//assert( x1 >= 0 && y1 >= 0 && x2 < surf->w && y2 < surf->h);//All pixels are in range
 
 			// Calculate weights of each source pixel
-			float w11 = ((origX - x1) * (origY - y1));
-			float w12 = ((origX - x1) * (y2 - origY));
-			float w21 = ((x2 - origX) * (origY - y1));
-			float w22 = ((x2 - origX) * (y2 - origY));
+			float w11 = (column.distLeft * (origY - y1));
+			float w12 = (column.distLeft * (y2 - origY));
+			float w21 = (column.distRight * (origY - y1));
+			float w22 = (column.distRight * (y2 - origY));
 			//assert( w11 + w12 + w21 + w22 > 0.99 && w11 + w12 + w21 + w22 < 1.01);//total weight is ~1.0
 
 			// Get pointers to source pixels
-			Uint8 *p11 = (Uint8*)surf->pixels + int(y1) * surf->pitch + int(x1) * bpp;
-			Uint8 *p12 = p11 + bpp;
-			Uint8 *p21 = p11 + surf->pitch;
-			Uint8 *p22 = p21 + bpp;
+			const Uint8 *p11 = srcRow + column.offset;
+			const Uint8 *p12 = p11 + bpp;
+			const Uint8 *p21 = p11 + surf->pitch;
+			const Uint8 *p22 = p21 + bpp;
 			// Calculate resulting channels
 #define PX(X, PTR) Channels::px<bpp>::X.get(PTR)
 			int resR = PX(r, p11) * w11 + PX(r, p12) * w12 + PX(r, p21) * w21 + PX(r, p22) * w22;
@@ -381,6 +381,7 @@ void CMapHandler::init()
 
 	prepareFOWDefs();
 	initTerrainGraphics();
+	terrainChunks.init();
 	initBorderGraphics();
 	logGlobal->info("\tPreparing FoW, terrain, roads, rivers, borders: %d ms", th.getDiff());
 	initObjectRects();
@@ -397,7 +398,7 @@ CMapHandler::CMapBlitter *CMapHandler::resolveBlitter(const MapDrawingInfo * inf
 	return normalBlitter;
 }
 
-void CMapHandler::CMapNormalBlitter::drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const
+void CMapHandler::CMapNormalBlitter::drawElement(EMapCacheType cacheType, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const
 {
 	source->draw(targetSurf, destRect, sourceRect);
 }
@@ -453,6 +454,39 @@ void CMapHandler::CMapNormalBlitter::init(const MapDrawingInfo * drawingInfo)
 		tileCount.y = parent->sizes.y + parent->frameH - topTile.y;
 }
 
+bool CMapHandler::CMapNormalBlitter::drawCachedTerrain(SDL_Surface * targetSurf)
+{
+	auto renderer = [this](SDL_Surface * chunkSurf, const Point & chunkPos, const int3 & origin, const int3 & size)
+	{
+		drawTerrainChunk(chunkSurf, chunkPos, origin, size);
+	};
+
+	parent->terrainChunks.draw(targetSurf, topTile, tileCount, initPos, tileSize, renderer);
+	return true;
+}
+
+void CMapHandler::CMapNormalBlitter::drawTerrainChunk(SDL_Surface * targetSurf, const Point & targetPos, const int3 & origin, const int3 & size)
+{
+	pos.z = origin.z;
+	for (realPos.x = targetPos.x, pos.x = origin.x; pos.x < origin.x + size.x; pos.x++, realPos.x += tileSize)
+	{
+		for (realPos.y = targetPos.y, pos.y = origin.y; pos.y < origin.y + size.y; pos.y++, realPos.y += tileSize)
+		{
+			realTileRect.x = realPos.x;
+			realTileRect.y = realPos.y;
+
+			const TerrainTile2 & tile = parent->ttiles[pos.x][pos.y][pos.z];
+			const TerrainTile & tinfo = parent->map->getTile(pos);
+			const TerrainTile * tinfoUpper = pos.y > 0 ? &parent->map->getTile(int3(pos.x, pos.y - 1, pos.z)) : nullptr;
+
+			drawTileTerrain(targetSurf, tinfo, tile);
+			if (tinfo.riverType)
+				drawRiver(targetSurf, tinfo);
+			drawRoad(targetSurf, tinfo, tinfoUpper);
+		}
+	}
+}
+
 SDL_Rect CMapHandler::CMapNormalBlitter::clip(SDL_Surface * targetSurf) const
 {
 	SDL_Rect prevClip;
@@ -535,9 +569,9 @@ void CMapHandler::CMapWorldViewBlitter::calculateWorldViewCameraPos()
 		topTile.y = parent->sizes.y - tileCount.y;
 }
 
-void CMapHandler::CMapWorldViewBlitter::drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const
+void CMapHandler::CMapWorldViewBlitter::drawElement(EMapCacheType cacheType, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const
 {
-	IImage * scaled = parent->cache.requestWorldViewCacheOrCreate(cacheType, source);
+	IImage * scaled = parent->cache.requestWorldViewCacheOrCreate(cacheType, key, source);
 
 	if(scaled)
 		scaled->draw(targetSurf, destRect, sourceRect);
@@ -603,21 +637,21 @@ void CMapHandler::CMapWorldViewBlitter::drawOverlayEx(SDL_Surface * targetSurf)
 	}
 }
 
-void CMapHandler::CMapWorldViewBlitter::drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const
+void CMapHandler::CMapWorldViewBlitter::drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const
 {
 	if (moving)
 		return;
 
-	CMapBlitter::drawHeroFlag(targetSurf, source, sourceRect, destRect, false);
+	CMapBlitter::drawHeroFlag(targetSurf, source, key, sourceRect, destRect, false);
 }
 
-void CMapHandler::CMapWorldViewBlitter::drawObject(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, bool moving) const
+void CMapHandler::CMapWorldViewBlitter::drawObject(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, bool moving) const
 {
 	if (moving)
 		return;
 
 	Rect scaledSourceRect(sourceRect->x * info->scale, sourceRect->y * info->scale, sourceRect->w, sourceRect->h);
-	CMapBlitter::drawObject(targetSurf, source, &scaledSourceRect, false);
+	CMapBlitter::drawObject(targetSurf, source, key, &scaledSourceRect, false);
 }
 
 void CMapHandler::CMapBlitter::drawTileTerrain(SDL_Surface * targetSurf, const TerrainTile & tinfo, const TerrainTile2 & tile) const
@@ -717,6 +751,11 @@ CMapHandler::CMapBlitter::CMapBlitter(CMapHandler * p)
 
 CMapHandler::CMapBlitter::~CMapBlitter() = default;
 
+void CMapHandler::CMapBlitter::drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const
+{
+	drawElement(cacheType, source, TImageKey(source, 0, 0), sourceRect, targetSurf, destRect);
+}
+
 void CMapHandler::CMapBlitter::drawFrame(SDL_Surface * targetSurf) const
 {
 	Rect destRect(realTileRect);
@@ -728,15 +767,15 @@ void CMapHandler::CMapBlitter::drawOverlayEx(SDL_Surface * targetSurf)
 //nothing to do here
 }
 
-void CMapHandler::CMapBlitter::drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const
+void CMapHandler::CMapBlitter::drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const
 {
-	drawElement(EMapCacheType::HERO_FLAGS, source, sourceRect, targetSurf, destRect);
+	drawElement(EMapCacheType::HERO_FLAGS, source, key, sourceRect, targetSurf, destRect);
 }
 
-void CMapHandler::CMapBlitter::drawObject(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, bool moving) const
+void CMapHandler::CMapBlitter::drawObject(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, bool moving) const
 {
 	Rect dstRect(realTileRect);
-	drawElement(EMapCacheType::OBJECTS, source, sourceRect, targetSurf, &dstRect);
+	drawElement(EMapCacheType::OBJECTS, source, key, sourceRect, targetSurf, &dstRect);
 }
 
 void CMapHandler::CMapBlitter::drawObjects(SDL_Surface * targetSurf, const TerrainTile2 & tile) const
@@ -774,19 +813,19 @@ void CMapHandler::CMapBlitter::drawObjects(SDL_Surface * targetSurf, const Terra
 		{
 			Rect srcRect(object.rect.x, object.rect.y, tileSize, tileSize);
 
-			drawObject(targetSurf, objData.objBitmap, &srcRect, objData.isMoving);
+			drawObject(targetSurf, objData.objBitmap, objData.objKey, &srcRect, objData.isMoving);
 			if (objData.flagBitmap)
 			{
 				if (objData.isMoving)
 				{
 					srcRect.y += FRAMES_PER_MOVE_ANIM_GROUP * 2 - tileSize;
 					Rect dstRect(realPos.x, realPos.y - tileSize / 2, tileSize, tileSize);
-					drawHeroFlag(targetSurf, objData.flagBitmap, &srcRect, &dstRect, true);
+					drawHeroFlag(targetSurf, objData.flagBitmap, objData.flagKey, &srcRect, &dstRect, true);
 				}
 				else if (obj->pos.x == pos.x && obj->pos.y == pos.y)
 				{
 					Rect dstRect(realPos.x - 2 * tileSize, realPos.y - tileSize, 3 * tileSize, 2 * tileSize);
-					drawHeroFlag(targetSurf, objData.flagBitmap, nullptr, &dstRect, false);
+					drawHeroFlag(targetSurf, objData.flagBitmap, objData.flagKey, nullptr, &dstRect, false);
 				}
 			}
 		}
@@ -845,6 +884,9 @@ void CMapHandler::CMapBlitter::blit(SDL_Surface * targetSurf, const MapDrawingIn
 	init(info);
 	auto prevClip = clip(targetSurf);
 
+	// tiles without drawn terrain are covered by full-hide fog, so terrain of whole viewport can be drawn at once
+	const bool terrainDrawn = drawCachedTerrain(targetSurf);
+
 	pos = int3(0, 0, topTile.z);
 
 	for (realPos.x = initPos.x, pos.x = topTile.x; pos.x < topTile.x + tileCount.x; pos.x++, realPos.x += tileSize)
@@ -866,7 +908,7 @@ void CMapHandler::CMapBlitter::blit(SDL_Surface * targetSurf, const MapDrawingIn
 			const TerrainTile & tinfo = parent->map->getTile(pos);
 			const TerrainTile * tinfoUpper = pos.y > 0 ? &parent->map->getTile(int3(pos.x, pos.y - 1, pos.z)) : nullptr;
 
-			if(isVisible || info->showAllTerrain)
+			if(!terrainDrawn && (isVisible || info->showAllTerrain))
 			{
 				drawTileTerrain(targetSurf, tinfo, tile);
 				if (tinfo.riverType)
@@ -987,9 +1029,13 @@ CMapHandler::AnimBitmapHolder CMapHandler::CMapBlitter::findHeroBitmap(const CGH
 			IImage * heroImage = animation->getImage(frame, group);
 
 			//get flag overlay only if we have main image
-			IImage * flagImage = findFlagBitmap(hero, anim, &hero->tempOwner, group);
+			TImageKey flagKey;
+			IImage * flagImage = findFlagBitmap(hero, anim, &hero->tempOwner, group, flagKey);
 
-			return CMapHandler::AnimBitmapHolder(heroImage, flagImage, moving);
+			CMapHandler::AnimBitmapHolder ret(heroImage, flagImage, moving);
+			ret.objKey = TImageKey(animation.get(), group, frame);
+			ret.flagKey = flagKey;
+			return ret;
 		}
 	}
 	return CMapHandler::AnimBitmapHolder();
@@ -1000,27 +1046,32 @@ CMapHandler::AnimBitmapHolder CMapHandler::CMapBlitter::findBoatBitmap(const CGB
 	auto animation = graphics->boatAnimations.at(boat->subID);
 	int group = getHeroFrameGroup(boat->direction, false);
 	if(animation->size(group) > 0)
-		return CMapHandler::AnimBitmapHolder(animation->getImage(anim % animation->size(group), group));
+	{
+		int frame = anim % animation->size(group);
+		CMapHandler::AnimBitmapHolder ret(animation->getImage(frame, group));
+		ret.objKey = TImageKey(animation.get(), group, frame);
+		return ret;
+	}
 	else
 		return CMapHandler::AnimBitmapHolder();
 }
 
-IImage * CMapHandler::CMapBlitter::findFlagBitmap(const CGHeroInstance * hero, int anim, const PlayerColor * color, int group) const
+IImage * CMapHandler::CMapBlitter::findFlagBitmap(const CGHeroInstance * hero, int anim, const PlayerColor * color, int group, TImageKey & key) const
 {
 	if (!hero)
 		return nullptr;
 
 	if (hero->boat)
-		return findBoatFlagBitmap(hero->boat, anim, color, group, hero->moveDir);
-	return findHeroFlagBitmap(hero, anim, color, group);
+		return findBoatFlagBitmap(hero->boat, anim, color, group, hero->moveDir, key);
+	return findHeroFlagBitmap(hero, anim, color, group, key);
 }
 
-IImage * CMapHandler::CMapBlitter::findHeroFlagBitmap(const CGHeroInstance * hero, int anim, const PlayerColor * color, int group) const
+IImage * CMapHandler::CMapBlitter::findHeroFlagBitmap(const CGHeroInstance * hero, int anim, const PlayerColor * color, int group, TImageKey & key) const
 {
-	return findFlagBitmapInternal(graphics->heroFlagAnimations.at(color->getNum()), anim, group, hero->moveDir, !hero->isStanding);
+	return findFlagBitmapInternal(graphics->heroFlagAnimations.at(color->getNum()), anim, group, hero->moveDir, !hero->isStanding, key);
 }
 
-IImage * CMapHandler::CMapBlitter::findBoatFlagBitmap(const CGBoat * boat, int anim, const PlayerColor * color, int group, ui8 dir) const
+IImage * CMapHandler::CMapBlitter::findBoatFlagBitmap(const CGBoat * boat, int anim, const PlayerColor * color, int group, ui8 dir, TImageKey & key) const
 {
 	int boatType = boat->subID;
 	if(boatType < 0 || boatType >= graphics->boatFlagAnimations.size())
@@ -1039,19 +1090,18 @@ IImage * CMapHandler::CMapBlitter::findBoatFlagBitmap(const CGBoat * boat, int a
 		return nullptr;
 	}
 
-	return findFlagBitmapInternal(subtypeFlags.at(colorIndex), anim, group, dir, false);
+	return findFlagBitmapInternal(subtypeFlags.at(colorIndex), anim, group, dir, false, key);
 }
 
-IImage * CMapHandler::CMapBlitter::findFlagBitmapInternal(std::shared_ptr<CAnimation> animation, int anim, int group, ui8 dir, bool moving) const
+IImage * CMapHandler::CMapBlitter::findFlagBitmapInternal(std::shared_ptr<CAnimation> animation, int anim, int group, ui8 dir, bool moving, TImageKey & key) const
 {
 	size_t groupSize = animation->size(group);
 	if(groupSize == 0)
 		return nullptr;
 
-	if(moving)
-		return animation->getImage(anim % groupSize, group);
-	else
-		return animation->getImage((anim / 4) % groupSize, group);
+	size_t frame = moving ? anim % groupSize : (anim / 4) % groupSize;
+	key = TImageKey(animation.get(), group, frame);
+	return animation->getImage(frame, group);
 }
 
 CMapHandler::AnimBitmapHolder CMapHandler::CMapBlitter::findObjectBitmap(const CGObjectInstance * obj, int anim) const
@@ -1069,13 +1119,16 @@ CMapHandler::AnimBitmapHolder CMapHandler::CMapBlitter::findObjectBitmap(const C
     if(groupSize == 0)
 		return CMapHandler::AnimBitmapHolder();
 
-	IImage * bitmap = animation->getImage((anim + getPhaseShift(obj)) % groupSize);
+	size_t frame = (anim + getPhaseShift(obj)) % groupSize;
+	IImage * bitmap = animation->getImage(frame);
 	if(!bitmap)
 		return CMapHandler::AnimBitmapHolder();
 
 	bitmap->setFlagColor(obj->tempOwner);
 
-	return CMapHandler::AnimBitmapHolder(bitmap);
+	CMapHandler::AnimBitmapHolder ret(bitmap);
+	ret.objKey = TImageKey(animation.get(), 0, frame);
+	return ret;
 }
 
 ui8 CMapHandler::CMapBlitter::getPhaseShift(const CGObjectInstance *object) const
@@ -1360,6 +1413,11 @@ void CMapHandler::updateWater() //shift colors in palettes of water tiles
 	}
 }
 
+void CMapHandler::invalidateTerrain(const int3 & tile)
+{
+	terrainChunks.invalidate(tile);
+}
+
 CMapHandler::~CMapHandler()
 {
 	delete normalBlitter;
@@ -1373,6 +1431,7 @@ CMapHandler::~CMapHandler()
 }
 
 CMapHandler::CMapHandler()
+	: terrainChunks(this)
 {
 	frameW = frameH = 0;
 	normalBlitter = new CMapNormalBlitter(this);
@@ -1437,9 +1496,8 @@ void CMapHandler::CMapCache::updateWorldViewScale(float scale)
 	worldViewCachedScale = scale;
 }
 
-IImage * CMapHandler::CMapCache::requestWorldViewCacheOrCreate(CMapHandler::EMapCacheType type, const IImage * fullSurface)
+IImage * CMapHandler::CMapCache::requestWorldViewCacheOrCreate(CMapHandler::EMapCacheType type, const TImageKey & key, const IImage * fullSurface)
 {
-	intptr_t key = (intptr_t) fullSurface;
 	auto & cache = data[(ui8)type];
 
 	auto iter = cache.find(key);
@@ -1456,6 +1514,168 @@ IImage * CMapHandler::CMapCache::requestWorldViewCacheOrCreate(CMapHandler::EMap
 	}
 }
 
+CMapHandler::CTerrainChunkCache::Chunk::Chunk()
+	: surface(nullptr),
+	  lastUsedFrame(0)
+{
+}
+
+CMapHandler::CTerrainChunkCache::CTerrainChunkCache(const CMapHandler * parent)
+	: parent(parent),
+	  currentFrame(0),
+	  renderedChunks(0),
+	  maxRenderedChunks(MIN_RENDERED_CHUNKS)
+{
+}
+
+CMapHandler::CTerrainChunkCache::~CTerrainChunkCache()
+{
+	clear();
+}
+
+void CMapHandler::CTerrainChunkCache::init()
+{
+	clear();
+
+	chunkCount.x = (parent->sizes.x + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunkCount.y = (parent->sizes.y + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunkCount.z = parent->sizes.z;
+
+	chunks.clear();
+	chunks.resize(chunkCount.x * chunkCount.y * chunkCount.z);
+	currentFrame = 0;
+	maxRenderedChunks = MIN_RENDERED_CHUNKS;
+}
+
+void CMapHandler::CTerrainChunkCache::clear()
+{
+	for(auto & chunk : chunks)
+		freeChunk(chunk);
+}
+
+CMapHandler::CTerrainChunkCache::Chunk & CMapHandler::CTerrainChunkCache::getChunk(int x, int y, int z)
+{
+	return chunks[(z * chunkCount.y + y) * chunkCount.x + x];
+}
+
+void CMapHandler::CTerrainChunkCache::freeChunk(Chunk & chunk)
+{
+	if(!chunk.surface)
+		return;
+
+	SDL_FreeSurface(chunk.surface);
+	chunk.surface = nullptr;
+	chunk.animatedTiles.clear();
+	renderedChunks--;
+}
+
+void CMapHandler::CTerrainChunkCache::invalidate(const int3 & tile)
+{
+	if(!parent->map || !parent->map->isInTheMap(tile))
+		return;
+
+	freeChunk(getChunk(tile.x / CHUNK_SIZE, tile.y / CHUNK_SIZE, tile.z));
+
+	// road of tile is partially drawn on tile below
+	if(tile.y + 1 < parent->sizes.y)
+		freeChunk(getChunk(tile.x / CHUNK_SIZE, (tile.y + 1) / CHUNK_SIZE, tile.z));
+}
+
+void CMapHandler::CTerrainChunkCache::evictLeastRecentlyUsed()
+{
+	Chunk * oldest = nullptr;
+	for(auto & chunk : chunks)
+	{
+		if(chunk.surface && chunk.lastUsedFrame != currentFrame && (!oldest || chunk.lastUsedFrame < oldest->lastUsedFrame))
+			oldest = &chunk;
+	}
+
+	if(oldest)
+		freeChunk(*oldest);
+}
+
+bool CMapHandler::CTerrainChunkCache::isAnimated(const TerrainTile & tinfo) const
+{
+	// must match palette shifts done in updateWater()
+	switch(tinfo.riverType)
+	{
+	case ERiverType::CLEAR_RIVER:
+	case ERiverType::MUDDY_RIVER:
+	case ERiverType::LAVA_RIVER:
+		return true;
+	default:
+		break;
+	}
+	return tinfo.terType == ETerrainType::LAVA || tinfo.terType == ETerrainType::WATER;
+}
+
+void CMapHandler::CTerrainChunkCache::renderChunk(Chunk & chunk, const int3 & origin, SDL_Surface * targetSurf, int tileSize, const TChunkRenderer & renderer)
+{
+	int3 size(CHUNK_SIZE, CHUNK_SIZE, 1);
+	vstd::amin(size.x, parent->sizes.x - origin.x);
+	vstd::amin(size.y, parent->sizes.y - origin.y);
+
+	chunk.surface = CSDL_Ext::newSurface(size.x * tileSize, size.y * tileSize, targetSurf);
+	SDL_SetSurfaceBlendMode(chunk.surface, SDL_BLENDMODE_NONE);
+	renderer(chunk.surface, Point(0, 0), origin, size);
+	renderedChunks++;
+
+	for(int y = origin.y; y < origin.y + size.y; y++)
+	{
+		for(int x = origin.x; x < origin.x + size.x; x++)
+		{
+			const int3 tile(x, y, origin.z);
+			if(isAnimated(parent->map->getTile(tile)))
+				chunk.animatedTiles.push_back(tile);
+		}
+	}
+}
+
+void CMapHandler::CTerrainChunkCache::draw(SDL_Surface * targetSurf, const int3 & topTile, const int3 & tileCount, const Point & initPos, int tileSize, const TChunkRenderer & renderer)
+{
+	currentFrame++;
+
+	const int firstX = std::max(0, topTile.x) / CHUNK_SIZE;
+	const int firstY = std::max(0, topTile.y) / CHUNK_SIZE;
+	const int lastX = std::min(parent->sizes.x, topTile.x + tileCount.x) - 1;
+	const int lastY = std::min(parent->sizes.y, topTile.y + tileCount.y) - 1;
+
+	if(lastX < 0 || lastY < 0)
+		return;
+
+	const size_t visibleChunks = (lastX / CHUNK_SIZE - firstX + 1) * (lastY / CHUNK_SIZE - firstY + 1);
+	vstd::amax(maxRenderedChunks, 2 * visibleChunks);
+
+	for(int cy = firstY; cy <= lastY / CHUNK_SIZE; cy++)
+	{
+		for(int cx = firstX; cx <= lastX / CHUNK_SIZE; cx++)
+		{
+			const int3 origin(cx * CHUNK_SIZE, cy * CHUNK_SIZE, topTile.z);
+			Chunk & chunk = getChunk(cx, cy, topTile.z);
+			chunk.lastUsedFrame = currentFrame;
+
+			if(!chunk.surface)
+			{
+				if(renderedChunks >= maxRenderedChunks)
+					evictLeastRecentlyUsed();
+				renderChunk(chunk, origin, targetSurf, tileSize, renderer);
+			}
+
+			Rect dest(initPos.x + (origin.x - topTile.x) * tileSize, initPos.y + (origin.y - topTile.y) * tileSize, chunk.surface->w, chunk.surface->h);
+			CSDL_Ext::blitSurface(chunk.surface, nullptr, targetSurf, &dest);
+
+			for(const int3 & tile : chunk.animatedTiles)
+			{
+				if(tile.x < topTile.x || tile.x >= topTile.x + tileCount.x || tile.y < topTile.y || tile.y >= topTile.y + tileCount.y)
+					continue;
+
+				const Point tilePos(initPos.x + (tile.x - topTile.x) * tileSize, initPos.y + (tile.y - topTile.y) * tileSize);
+				renderer(targetSurf, tilePos, tile, int3(1, 1, 1));
+			}
+		}
+	}
+}
+
 bool CMapHandler::compareObjectBlitOrder(const CGObjectInstance * a, const CGObjectInstance * b)
 {
 	if (!a)
@@ -155,10 +155,14 @@ class CMapHandler
 		TERRAIN, OBJECTS, ROADS, RIVERS, FOW, HEROES, HERO_FLAGS, FRAME, AFTER_LAST
 	};
 
+	/// identifies source image of world view cache: animation, group and frame for frames of map object animations,
+	/// which may be unloaded and loaded again at different address; image address for images that are never unloaded
+	typedef std::tuple<const void *, size_t, size_t> TImageKey;
+
 	/// temporarily caches rescaled frames for map world view redrawing
 	class CMapCache
 	{
-		std::array< std::map<intptr_t, std::unique_ptr<IImage>>, (ui8)EMapCacheType::AFTER_LAST> data;
+		std::array< std::map<TImageKey, std::unique_ptr<IImage>>, (ui8)EMapCacheType::AFTER_LAST> data;
 		float worldViewCachedScale;
 	public:
 		CMapCache();
@@ -167,7 +171,53 @@ class CMapHandler
 		/// updates scale and determines if currently cached data is still valid
 		void updateWorldViewScale(float scale);
 		/// asks for cached data; @returns cached data if found, new scaled surface otherwise, may return nullptr in case of scaling error
-		IImage * requestWorldViewCacheOrCreate(EMapCacheType type, const IImage * fullSurface);
+		IImage * requestWorldViewCacheOrCreate(EMapCacheType type, const TImageKey & key, const IImage * fullSurface);
+	};
+
+	/// caches pre-rendered terrain, rivers and roads in square chunks of tiles; used by normal (not scaled) map view
+	/// tiles with palette animation (water, lava, some rivers) are redrawn on top of cached chunk every frame
+	class CTerrainChunkCache
+	{
+	public:
+		static const int CHUNK_SIZE = 16; // length of chunk side [in tiles]
+		static const size_t MIN_RENDERED_CHUNKS = 16;
+		/// draws tiles of map [first tile, size in tiles] into surface starting at given position
+		typedef std::function<void(SDL_Surface *, const Point &, const int3 &, const int3 &)> TChunkRenderer;
+
+	private:
+		struct Chunk
+		{
+			SDL_Surface * surface; // nullptr if chunk is not rendered
+			std::vector<int3> animatedTiles;
+			ui32 lastUsedFrame;
+
+			Chunk();
+		};
+
+		const CMapHandler * parent;
+		int3 chunkCount; // number of chunks in each dimension
+		std::vector<Chunk> chunks; // [level][chunk row][chunk column]
+		ui32 currentFrame;
+		size_t renderedChunks;
+		size_t maxRenderedChunks; // grows with number of chunks needed to fill viewport
+
+		Chunk & getChunk(int x, int y, int z);
+		void freeChunk(Chunk & chunk);
+		void evictLeastRecentlyUsed();
+		void renderChunk(Chunk & chunk, const int3 & origin, SDL_Surface * targetSurf, int tileSize, const TChunkRenderer & renderer);
+		bool isAnimated(const TerrainTile & tinfo) const;
+	public:
+		CTerrainChunkCache(const CMapHandler * parent);
+		~CTerrainChunkCache();
+
+		/// creates empty cache for current map
+		void init();
+		/// frees all rendered chunks
+		void clear();
+		/// discards chunks that display given tile
+		void invalidate(const int3 & tile);
+		/// draws terrain of visible part of map; top-left tile is drawn at initPos, missing chunks are rendered via renderer
+		void draw(SDL_Surface * targetSurf, const int3 & topTile, const int3 & tileCount, const Point & initPos, int tileSize, const TChunkRenderer & renderer);
 	};
 
 	/// helper struct to pass around resolved bitmaps of an object; images can be nullptr if object doesn't have bitmap of that type
@@ -175,11 +225,14 @@ class CMapHandler
 	{
 		IImage * objBitmap; // main object bitmap
 		IImage * flagBitmap; // flag bitmap for the object (probably only for heroes and boats with heroes)
+		TImageKey objKey, flagKey; // keys of bitmaps in world view cache
 		bool isMoving; // indicates if the object is moving (again, heroes/boats only)
 
 		AnimBitmapHolder(IImage * objBitmap_ = nullptr, IImage * flagBitmap_ = nullptr, bool moving = false)
 			: objBitmap(objBitmap_),
 			  flagBitmap(flagBitmap_),
+			  objKey(objBitmap_, 0, 0),
+			  flagKey(flagBitmap_, 0, 0),
 			  isMoving(moving)
 		{}
 	};
@@ -201,10 +254,14 @@ class CMapHandler
 		const MapDrawingInfo * info; // data for drawing passed from outside
 
 		/// general drawing method, called internally by more specialized ones
-		virtual void drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const = 0;
+		virtual void drawElement(EMapCacheType cacheType, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const = 0;
+		/// draws image that is never unloaded, e.g. terrain
+		void drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const;
 
 		// first drawing pass
 
+		/// draws terrain of whole viewport at once if blitter supports it; @returns false if terrain has to be drawn per tile
+		virtual bool drawCachedTerrain(SDL_Surface * targetSurf) { return false; }
 		/// draws terrain bitmap (or custom bitmap if applicable) on current tile
 		virtual void drawTileTerrain(SDL_Surface * targetSurf, const TerrainTile & tinfo, const TerrainTile2 & tile) const;
 		/// draws a river segment on current tile
@@ -213,8 +270,8 @@ class CMapHandler
 		virtual void drawRoad(SDL_Surface * targetSurf, const TerrainTile & tinfo, const TerrainTile * tinfoUpper) const;
 		/// draws all objects on current tile (higher-level logic, unlike other draw*** methods)
 		virtual void drawObjects(SDL_Surface * targetSurf, const TerrainTile2 & tile) const;
-		virtual void drawObject(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, bool moving) const;
-		virtual void drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const;
+		virtual void drawObject(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, bool moving) const;
+		virtual void drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const;
 
 		// second drawing pass
 
@@ -248,10 +305,10 @@ class CMapHandler
 		// internal helper methods to choose correct bitmap(s) for object; called internally by findObjectBitmap
 		AnimBitmapHolder findHeroBitmap(const CGHeroInstance * hero, int anim) const;
 		AnimBitmapHolder findBoatBitmap(const CGBoat * hero, int anim) const;
-		IImage * findFlagBitmap(const CGHeroInstance * obj, int anim, const PlayerColor * color, int group) const;
-		IImage * findHeroFlagBitmap(const CGHeroInstance * obj, int anim, const PlayerColor * color, int group) const;
-		IImage * findBoatFlagBitmap(const CGBoat * obj, int anim, const PlayerColor * color, int group, ui8 dir) const;
-		IImage * findFlagBitmapInternal(std::shared_ptr<CAnimation> animation, int anim, int group, ui8 dir, bool moving) const;
+		IImage * findFlagBitmap(const CGHeroInstance * obj, int anim, const PlayerColor * color, int group, TImageKey & key) const;
+		IImage * findHeroFlagBitmap(const CGHeroInstance * obj, int anim, const PlayerColor * color, int group, TImageKey & key) const;
+		IImage * findBoatFlagBitmap(const CGBoat * obj, int anim, const PlayerColor * color, int group, ui8 dir, TImageKey & key) const;
+		IImage * findFlagBitmapInternal(std::shared_ptr<CAnimation> animation, int anim, int group, ui8 dir, bool moving, TImageKey & key) const;
 
 	public:
 		CMapBlitter(CMapHandler * p);
@@ -263,8 +320,11 @@ class CMapHandler
 
 	class CMapNormalBlitter : public CMapBlitter
 	{
+		/// renders terrain, rivers and roads of given tiles into chunk of terrain cache
+		void drawTerrainChunk(SDL_Surface * targetSurf, const Point & targetPos, const int3 & origin, const int3 & size);
 	protected:
-		void drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const override;
+		bool drawCachedTerrain(SDL_Surface * targetSurf) override;
+		void drawElement(EMapCacheType cacheType, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const override;
 		void drawTileOverlay(SDL_Surface * targetSurf,const TerrainTile2 & tile) const override {}
 		void init(const MapDrawingInfo * info) override;
 		SDL_Rect clip(SDL_Surface * targetSurf) const override;
@@ -278,10 +338,10 @@ class CMapHandler
 	private:
 		IImage * objectToIcon(Obj id, si32 subId, PlayerColor owner) const;
 	protected:
-		void drawElement(EMapCacheType cacheType, const IImage * source, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const override;
+		void drawElement(EMapCacheType cacheType, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Surface * targetSurf, SDL_Rect * destRect) const override;
 		void drawTileOverlay(SDL_Surface * targetSurf, const TerrainTile2 & tile) const override;
-		void drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const override;
-		void drawObject(SDL_Surface * targetSurf, const IImage * source, SDL_Rect * sourceRect, bool moving) const override;
+		void drawHeroFlag(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, SDL_Rect * destRect, bool moving) const override;
+		void drawObject(SDL_Surface * targetSurf, const IImage * source, const TImageKey & key, SDL_Rect * sourceRect, bool moving) const override;
 		void drawFrame(SDL_Surface * targetSurf) const override {}
 		void drawOverlayEx(SDL_Surface * targetSurf) override;
 		void init(const MapDrawingInfo * info) override;
@@ -307,6 +367,7 @@ class CMapHandler
 	};
 
 	CMapCache cache;
+	CTerrainChunkCache terrainChunks;
 	CMapBlitter * normalBlitter;
 	CMapBlitter * worldViewBlitter;
 	CMapBlitter * puzzleViewBlitter;
@@ -380,6 +441,8 @@ public:
 
 	EMapAnimRedrawStatus drawTerrainRectNew(SDL_Surface * targetSurface, const MapDrawingInfo * info, bool redrawOnlyAnim = false);
 	void updateWater();
+	/// should be called when terrain, river or road of tile changes
+	void invalidateTerrain(const int3 & tile);
 	/// determines if the map is ready to handle new hero movement (not available during fading animations)
 	bool canStartHeroMovement();
 
@@ -673,6 +673,22 @@ void CMinimap::showTile(const int3 &pos)
 		minimap->refreshTile(pos);
 }
 
+void CMinimap::updateTiles(const std::unordered_set<int3, ShashInt3> & tiles)
+{
+	if (!minimap)
+		return;
+
+	int3 mapSizes = LOCPLINT->cb->getMapSize();
+	if (tiles.size() > mapSizes.x * mapSizes.y / 4)
+	{
+		update();
+		return;
+	}
+
+	for (auto & tile : tiles)
+		minimap->refreshTile(tile);
+}
+
 CInfoBar::CVisibleInfo::CVisibleInfo(Point position):
 	CIntObject(0, position),
 	aiProgress(nullptr)
@@ -237,6 +237,8 @@ public:
 
 	void hideTile(const int3 &pos); //puts FoW
 	void showTile(const int3 &pos); //removes FoW
+	/// refreshes all changed tiles, large changes are handled by redrawing whole minimap
+	void updateTiles(const std::unordered_set<int3, ShashInt3> & tiles);
 };
 
 /// Info box which shows next week/day information, hold the current date
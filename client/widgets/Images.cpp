@@ -321,7 +321,7 @@ CShowableAnim::CShowableAnim(int x, int y, std::string name, ui8 Flags, ui32 Del
 	yOffset(0),
 	alpha(255)
 {
-	anim->loadGroup(group);
+	anim->loadGroupAsync(group);
 	last = anim->size(group);
 
 	pos.w = anim->getImage(0, group)->width();
@@ -1843,6 +1843,7 @@ void CAdvMapInt::aiTurnStarted()
 	adventureInt->minimap.setAIRadar(true);
 	adventureInt->infoBar.startEnemyTurn(LOCPLINT->cb->getCurrentPlayer());
 	adventureInt->infoBar.showAll(screen);//force refresh on inactive object
+	GH.invalidate(adventureInt->infoBar.pos);
 }
 
 void CAdvMapInt::adjustActiveness(bool aiTurnStart)
@@ -450,6 +450,19 @@ std::vector <const CGObjectInstance * > CGameInfoCallback::getVisitableObjs(int3
 
 	return ret;
 }
+std::vector <const CGObjectInstance * > CGameInfoCallback::getVisitableObjsInRange(int3 pos, int radius, Obj type) const
+{
+	std::vector<const CGObjectInstance *> ret;
+	for(const CGObjectInstance * obj : gs->map->getObjectsInRange(pos, radius, type))
+	{
+		if(!isVisible(obj->visitablePos()))
+			continue;
+		if(player || obj->ID != Obj::EVENT) //hide events from players
+			ret.push_back(obj);
+	}
+	return ret;
+}
+
 const CGObjectInstance * CGameInfoCallback::getTopObj (int3 pos) const
 {
 	return vstd::backOrNull(getVisitableObjs(pos));
@@ -515,6 +528,34 @@ std::shared_ptr<boost::multi_array<TerrainTile*, 3>> CGameInfoCallback::getAllVi
 	return std::make_shared<boost::multi_array<TerrainTile*, 3>>(tileArray);
 }
 
+CVisibleTilesView CGameInfoCallback::getVisibleTilesView() const
+{
+	assert(player.is_initialized());
+	return CVisibleTilesView(gs->map, getPlayerTeam(player.get()));
+}
+
+ui64 CGameInfoCallback::getJournalVersion() const
+{
+	return gs->journal.getVersion();
+}
+
+GameStateChanges CGameInfoCallback::getChangesSince(ui64 version) const
+{
+	return gs->journal.getChangesSince(version);
+}
+
+bool CGameInfoCallback::hasTileChangesSince(ui64 version) const
+{
+	if(!player)
+		return gs->journal.hasTileChangesSince(version);
+
+	//changes under fog of war are not known to player, revealing tiles is recorded as their change
+	return gs->journal.hasTileChangesSince(version, [this](const int3 & tile)
+	{
+		return isVisible(tile);
+	});
+}
+
 EBuildingState::EBuildingState CGameInfoCallback::canBuildStructure( const CGTownInstance *t, BuildingID ID )
 {
 	ERROR_RET_VAL_IF(!canGetFullInfo(t), "Town is not owned!", EBuildingState::TOWN_NOT_OWNED);
@@ -998,3 +1039,26 @@ void IGameEventRealizer::setObjProperty(ObjectInstanceID objid, int prop, si64 v
 	sob.val = static_cast<ui32>(val);
 	commitPackage(&sob);
 }
+
+CVisibleTilesView::CVisibleTilesView(const CMap * map, const TeamState * team)
+	: map(map), team(team)
+{
+
+}
+
+const TerrainTile * CVisibleTilesView::getTile(const int3 & pos) const
+{
+	if(!map->isInTheMap(pos) || !team->fogOfWarMap[pos.x][pos.y][pos.z])
+		return nullptr;
+	return &map->getTile(pos);
+}
+
+int3 CVisibleTilesView::getSize() const
+{
+	return int3(map->width, map->height, map->twoLevel ? 2 : 1);
+}
+
+ui32 CVisibleTilesView::getVersion() const
+{
+	return team->fogOfWarVersion;
+}
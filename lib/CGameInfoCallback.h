@@ -17,6 +17,7 @@ struct InfoWindow;
 struct PlayerSettings;
 struct CPackForClient;
 struct TerrainTile;
+struct GameStateChanges;
 struct PlayerState;
 class CTown;
 struct StartInfo;
@@ -29,6 +30,22 @@ class CMapHeader;
 struct TeamState;
 struct QuestInfo;
 class int3;
+class CMap;
+
+/// Read-only view of map tiles visible to a team. Nothing is copied, view always reflects current state of the map.
+class DLL_LINKAGE CVisibleTilesView
+{
+	const CMap * map;
+	const TeamState * team;
+public:
+	CVisibleTilesView(const CMap * map, const TeamState * team);
+
+	/// returns nullptr for tiles which are hidden or outside of the map
+	const TerrainTile * getTile(const int3 & pos) const;
+	int3 getSize() const;
+	/// changes whenever visibility of any tile changes
+	ui32 getVersion() const;
+};
 
 
 class DLL_LINKAGE CGameInfoCallback : public virtual CCallbackBase
@@ -79,6 +96,8 @@ public:
 	const CGObjectInstance* getObj(ObjectInstanceID objid, bool verbose = true) const;
 	std::vector <const CGObjectInstance * > getBlockingObjs(int3 pos)const;
 	std::vector <const CGObjectInstance * > getVisitableObjs(int3 pos, bool verbose = true)const;
+	/// visible objects with visitable position at most radius tiles away from pos (square area), in no particular order
+	std::vector <const CGObjectInstance * > getVisitableObjsInRange(int3 pos, int radius, Obj type = Obj::NO_OBJ) const;
 	std::vector <const CGObjectInstance * > getFlaggableObjects(int3 pos) const;
 	const CGObjectInstance * getTopObj (int3 pos) const;
 	PlayerColor getOwner(ObjectInstanceID heroID) const;
@@ -91,8 +110,14 @@ public:
 	int3 getMapSize() const; //returns size of map - z is 1 for one - level map and 2 for two level map
 	const TerrainTile * getTile(int3 tile, bool verbose = true) const;
 	std::shared_ptr<boost::multi_array<TerrainTile*, 3>> getAllVisibleTiles() const;
+	CVisibleTilesView getVisibleTilesView() const;
 	bool isInTheMap(const int3 &pos) const;
 
+	//game state journal
+	ui64 getJournalVersion() const;
+	GameStateChanges getChangesSince(ui64 version) const; //what was changed by packs applied after given version
+	bool hasTileChangesSince(ui64 version) const; //cheap check if any tile visible to player was changed by packs applied after given version
+
 	//town
 	const CGTownInstance* getTown(ObjectInstanceID objid) const;
 	int howManyTowns(PlayerColor Player) const;
@@ -68,8 +68,19 @@ public:
 		T *ptr = static_cast<T*>(pack);
 
 		boost::unique_lock<boost::shared_mutex> lock(CGameState::mutex);
-		ptr->applyGs(gs);
+		if(modifiesGameState)
+		{
+			gs->journal.beginEntry();
+			ptr->applyGs(gs);
+			gs->journal.endEntry();
+		}
+		else
+			ptr->applyGs(gs);
 	}
+
+private:
+	/// packs that only inherit CPack::applyGs don't touch game state and get no journal entry
+	static const bool modifiesGameState = !std::is_same<decltype(&T::applyGs), void (CPack::*)(CGameState *)>::value;
 };
 
 static CApplier<CBaseForGSApply> *applierGs = nullptr;
@@ -2029,7 +2040,7 @@ std::vector<CGObjectInstance*> CGameState::guardingCreatures (int3 pos) const
 
 int3 CGameState::guardingCreaturePosition (int3 pos) const
 {
-	return gs->map->guardingCreaturePositions[pos.x][pos.y][pos.z];
+	return gs->map->guardingCreaturePositions[gs->map->getTileIndex(pos)];
 }
 
 void CGameState::updateRumor()
@@ -3068,13 +3079,15 @@ int ArmyDescriptor::getStrength() const
 }
 
 TeamState::TeamState()
+	: fogOfWarVersion(0)
 {
 	setNodeType(TEAM);
 }
 
 TeamState::TeamState(TeamState && other):
 	CBonusSystemNode(std::move(other)),
-	id(other.id)
+	id(other.id),
+	fogOfWarVersion(other.fogOfWarVersion)
 {
 	std::swap(players, other.players);
 	std::swap(fogOfWarMap, other.fogOfWarMap);
@@ -20,6 +20,7 @@
 #include "int3.h"
 #include "CRandomGenerator.h"
 #include "CGameStateFwd.h"
+#include "CGameStateJournal.h"
 #include "CPathfinder.h"
 
 class CTown;
@@ -163,6 +164,7 @@ public:
 	std::map<TeamID, TeamState> teams;
 	CBonusSystemNode globalEffects;
 	RumorState rumor;
+	CGameStateJournal journal; //not serialized, changes done by applied packs
 
 	static boost::shared_mutex mutex;
 
@@ -0,0 +1,164 @@
+/*
+ * CGameStateJournal.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "CGameStateJournal.h"
+
+#include "mapObjects/CObjectHandler.h"
+#include "NetPacks.h"
+
+GameStateChanges::GameStateChanges()
+	: everything(false)
+{
+}
+
+bool GameStateChanges::empty() const
+{
+	return !everything && tiles.empty() && objects.empty() && bonusOwners.empty() && players.empty();
+}
+
+void GameStateChanges::merge(const GameStateChanges & other)
+{
+	everything |= other.everything;
+	tiles.insert(other.tiles.begin(), other.tiles.end());
+	objects.insert(other.objects.begin(), other.objects.end());
+	bonusOwners.insert(other.bonusOwners.begin(), other.bonusOwners.end());
+	players.insert(other.players.begin(), other.players.end());
+}
+
+CGameStateJournal::CGameStateJournal()
+	: recorded(false), version(0)
+{
+}
+
+ui64 CGameStateJournal::getVersion() const
+{
+	return version;
+}
+
+GameStateChanges CGameStateJournal::getChangesSince(ui64 since) const
+{
+	GameStateChanges ret;
+	if(since >= version)
+		return ret;
+
+	if(entries.empty() || entries.front().version > since + 1)
+	{
+		ret.everything = true; //entries we need were already dropped
+		return ret;
+	}
+
+	for(auto it = entries.rbegin(); it != entries.rend() && it->version > since; ++it)
+		ret.merge(it->changes);
+
+	return ret;
+}
+
+bool CGameStateJournal::hasTileChangesSince(ui64 since, const std::function<bool(const int3 &)> & filter) const
+{
+	if(since >= version)
+		return false;
+
+	if(entries.empty() || entries.front().version > since + 1)
+		return true;
+
+	for(auto it = entries.rbegin(); it != entries.rend() && it->version > since; ++it)
+	{
+		if(it->changes.everything)
+			return true;
+		if(!filter && !it->changes.tiles.empty())
+			return true;
+		if(filter && vstd::contains_if(it->changes.tiles, filter))
+			return true;
+	}
+	return false;
+}
+
+void CGameStateJournal::beginEntry()
+{
+	current = GameStateChanges();
+	recorded = false;
+}
+
+void CGameStateJournal::endEntry()
+{
+	//pack did not describe its changes - be conservative
+	if(!recorded)
+		current.everything = true;
+
+	Entry entry;
+	entry.version = ++version;
+	entry.changes = std::move(current);
+	entries.push_back(std::move(entry));
+
+	if(entries.size() > MAX_ENTRIES)
+		entries.pop_front();
+
+	current = GameStateChanges();
+}
+
+void CGameStateJournal::recordTile(const int3 & tile)
+{
+	recorded = true;
+	current.tiles.insert(tile);
+}
+
+void CGameStateJournal::recordTiles(const std::unordered_set<int3, ShashInt3> & tiles)
+{
+	recorded = true;
+	current.tiles.insert(tiles.begin(), tiles.end());
+}
+
+void CGameStateJournal::recordTiles(const std::vector<TileRun> & runs)
+{
+	recorded = true;
+	TileRun::toTiles(runs, current.tiles);
+}
+
+void CGameStateJournal::recordObject(ObjectInstanceID id)
+{
+	recorded = true;
+	current.objects.insert(id);
+}
+
+void CGameStateJournal::recordObject(const CGObjectInstance * obj)
+{
+	recordObject(obj->id);
+	for(const int3 & tile : obj->getBlockedPos())
+		current.tiles.insert(tile);
+	if(obj->isVisitable())
+		current.tiles.insert(obj->visitablePos());
+
+	//monsters guard neighbouring tiles as well
+	if(obj->ID == Obj::MONSTER)
+	{
+		int3 pos = obj->visitablePos();
+		for(int dx = -1; dx <= 1; dx++)
+			for(int dy = -1; dy <= 1; dy++)
+				current.tiles.insert(pos + int3(dx, dy, 0));
+	}
+}
+
+void CGameStateJournal::recordBonuses(ObjectInstanceID owner)
+{
+	recorded = true;
+	current.bonusOwners.insert(owner);
+}
+
+void CGameStateJournal::recordPlayer(PlayerColor player)
+{
+	recorded = true;
+	current.players.insert(player);
+}
+
+void CGameStateJournal::recordEverything()
+{
+	recorded = true;
+	current.everything = true;
+}
@@ -0,0 +1,76 @@
+/*
+ * CGameStateJournal.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "int3.h"
+#include "GameConstants.h"
+
+class CGObjectInstance;
+struct TileRun;
+
+/// Summary of game state changes done by one or more applied packs
+struct DLL_LINKAGE GameStateChanges
+{
+	std::unordered_set<int3, ShashInt3> tiles;
+	std::set<ObjectInstanceID> objects;
+	std::set<ObjectInstanceID> bonusOwners; //objects whose own or commander's bonuses changed, player bonuses are recorded as players
+	std::set<PlayerColor> players;
+	/// changes are not known in detail, consumers must assume that anything may have changed
+	bool everything;
+
+	GameStateChanges();
+	bool empty() const;
+	void merge(const GameStateChanges & other);
+};
+
+/// Journal of changes applied to game state. Every pack that modifies game state gets an entry
+/// with increasing version so caches can be updated incrementally instead of being dropped.
+/// Journal is not serialized, versions are only meaningful for the game state that produced them.
+class DLL_LINKAGE CGameStateJournal
+{
+public:
+	/// older entries are dropped, consumers that fall that much behind get "everything" changed
+	static const size_t MAX_ENTRIES = 4096;
+
+	CGameStateJournal();
+
+	ui64 getVersion() const;
+	/// returns all changes done after given version
+	GameStateChanges getChangesSince(ui64 version) const;
+	/// checks if any tile may have changed after given version, without merging entries
+	/// if filter is given, only tiles for which it returns true are considered
+	bool hasTileChangesSince(ui64 version, const std::function<bool(const int3 &)> & filter = nullptr) const;
+
+	/// used by CGameState::apply around applyGs of every pack
+	void beginEntry();
+	void endEntry();
+
+	/// used by applyGs of packs to describe what they changed
+	void recordTile(const int3 & tile);
+	void recordTiles(const std::unordered_set<int3, ShashInt3> & tiles);
+	void recordTiles(const std::vector<TileRun> & runs);
+	void recordObject(ObjectInstanceID id);
+	void recordObject(const CGObjectInstance * obj); //also records all tiles covered by object
+	void recordBonuses(ObjectInstanceID owner);
+	void recordPlayer(PlayerColor player);
+	void recordEverything();
+
+private:
+	struct Entry
+	{
+		ui64 version;
+		GameStateChanges changes;
+	};
+
+	std::deque<Entry> entries;
+	GameStateChanges current;
+	bool recorded;
+	ui64 version;
+};
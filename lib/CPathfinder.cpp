@@ -865,6 +865,50 @@ TurnInfo::TurnInfo(const CGHeroInstance * Hero, const int turn)
 	bonuses = hero->getAllBonuses(Selector::days(turn), nullptr, nullptr, cachingStr.str());
 	bonusCache = make_unique<BonusCache>(bonuses);
 	nativeTerrain = hero->getNativeTerrain();
+	maxMovePointsLand = hero->maxMovePoints(true, this);
+	maxMovePointsWater = hero->maxMovePoints(false, this);
+	initMovementCosts();
+}
+
+void TurnInfo::initMovementCosts()
+{
+	const int pathfinding = bonuses->valOfBonuses(Selector::typeSubtype(Bonus::SECONDARY_SKILL_PREMY, SecondarySkill::PATHFINDING));
+	const double flyingModifier = (100.0 + bonusCache->flyingMovementVal) / 100.0;
+	const double waterWalkingModifier = (100.0 + bonusCache->waterWalkingVal) / 100.0;
+
+	for(int terrain = 0; terrain < GameConstants::TERRAIN_TYPES; terrain++)
+	{
+		int terrainCost = GameConstants::BASE_MOVEMENT_COST;
+		bool noPenalty = terrain < ETerrainType::ROCK && bonusCache->noTerrainPenalty[terrain];
+		if(nativeTerrain != terrain && !noPenalty)
+			terrainCost = std::max<int>(VLC->heroh->terrCosts[terrain] - pathfinding, GameConstants::BASE_MOVEMENT_COST);
+
+		for(int road = 0; road <= UNKNOWN_ROAD; road++)
+		{
+			int cost = terrainCost;
+			switch(road)
+			{
+			case UNKNOWN_ROAD:
+				cost = GameConstants::BASE_MOVEMENT_COST;
+				break;
+			case ERoadType::DIRT_ROAD:
+				cost = 75;
+				break;
+			case ERoadType::GRAVEL_ROAD:
+				cost = 65;
+				break;
+			case ERoadType::COBBLESTONE_ROAD:
+				cost = 50;
+				break;
+			}
+
+			int * costs = movementCosts[terrain][road];
+			costs[NO_MODIFIER] = cost;
+			costs[FLYING_OVER_BLOCKED] = cost * flyingModifier;
+			costs[WATER_WALKING] = cost * waterWalkingModifier;
+			costs[FAVORABLE_WINDS] = cost * 0.666;
+		}
+	}
 }
 
 bool TurnInfo::isLayerAvailable(const EPathfindingLayer layer) const
@@ -920,14 +964,49 @@ int TurnInfo::valOfBonuses(Bonus::BonusType type, int subtype) const
 
 int TurnInfo::getMaxMovePoints(const EPathfindingLayer layer) const
 {
-	if(maxMovePointsLand == -1)
-		maxMovePointsLand = hero->maxMovePoints(true, this);
-	if(maxMovePointsWater == -1)
-		maxMovePointsWater = hero->maxMovePoints(false, this);
-
 	return layer == EPathfindingLayer::SAIL ? maxMovePointsWater : maxMovePointsLand;
 }
 
+const int * TurnInfo::getCosts(const TerrainTile & dest, const TerrainTile & from) const
+{
+	//if there is road both on dest and src tiles - use road movement cost
+	int road = std::min(dest.roadType, from.roadType);
+	if(road < ERoadType::NO_ROAD || road > ERoadType::COBBLESTONE_ROAD)
+	{
+		logGlobal->error("Unknown road type: %d", road);
+		road = UNKNOWN_ROAD;
+	}
+
+	return movementCosts[from.terType][road];
+}
+
+int TurnInfo::getTileCost(const TerrainTile & dest, const TerrainTile & from) const
+{
+	return getCosts(dest, from)[NO_MODIFIER];
+}
+
+int TurnInfo::getMovementCost(const TerrainTile & dest, const TerrainTile & from, const bool inBoat) const
+{
+	ECostModifier modifier = NO_MODIFIER;
+	if(dest.blocked && bonusCache->flyingMovement)
+		modifier = FLYING_OVER_BLOCKED;
+	else if(dest.terType == ETerrainType::WATER)
+	{
+		if(inBoat && from.hasFavorableWinds() && dest.hasFavorableWinds())
+			modifier = FAVORABLE_WINDS;
+		else if(!inBoat && bonusCache->waterWalking)
+			modifier = WATER_WALKING;
+	}
+
+	return getCosts(dest, from)[modifier];
+}
+
+int TurnInfo::getMinMovementCost() const
+{
+	const int * first = &movementCosts[0][0][0];
+	return *std::min_element(first, first + GameConstants::TERRAIN_TYPES * (ROAD_TYPES + 1) * COST_MODIFIERS);
+}
+
 CPathfinderHelper::CPathfinderHelper(const CGHeroInstance * Hero, const CPathfinder::PathfinderOptions & Options)
 	: turn(-1), hero(Hero), options(Options)
 {
@@ -1053,25 +1132,11 @@ int CPathfinderHelper::getMovementCost(const CGHeroInstance * h, const int3 & sr
 	/// TODO: by the original game rules hero shouldn't be affected by terrain penalty while flying.
 	/// Also flying movement only has penalty when player moving over blocked tiles.
 	/// So if you only have base flying with 40% penalty you can still ignore terrain penalty while having zero flying penalty.
-	int ret = h->getTileCost(*dt, *ct, ti);
+	int ret = ti->getMovementCost(*dt, *ct, h->boat != nullptr);
 	/// Unfortunately this can't be implemented yet as server don't know when player flying and when he's not.
 	/// Difference in cost calculation on client and server is much worse than incorrect cost.
 	/// So this one is waiting till server going to use pathfinder rules for path validation.
 
-	if(dt->blocked && ti->hasBonusOfType(Bonus::FLYING_MOVEMENT))
-	{
-		ret *= (100.0 + ti->valOfBonuses(Bonus::FLYING_MOVEMENT)) / 100.0;
-	}
-	else if(dt->terType == ETerrainType::WATER)
-	{
-		if(h->boat && ct->hasFavorableWinds() && dt->hasFavorableWinds())
-			ret *= 0.666;
-		else if(!h->boat && ti->hasBonusOfType(Bonus::WATER_WALKING))
-		{
-			ret *= (100.0 + ti->valOfBonuses(Bonus::WATER_WALKING)) / 100.0;
-		}
-	}
-
 	if(src.x != dst.x && src.y != dst.y) //it's diagonal move
 	{
 		int old = ret;
@@ -245,17 +245,39 @@ struct DLL_LINKAGE TurnInfo
 	};
 	std::unique_ptr<BonusCache> bonusCache;
 
+	/// Modifiers applied on top of tile cost depending on how hero enters destination tile
+	enum ECostModifier
+	{
+		NO_MODIFIER = 0, FLYING_OVER_BLOCKED, WATER_WALKING, FAVORABLE_WINDS, COST_MODIFIERS
+	};
+	static const int ROAD_TYPES = ERoadType::COBBLESTONE_ROAD + 1;
+	/// Table row used when road type is not known, such road costs base movement
+	static const int UNKNOWN_ROAD = ROAD_TYPES;
+
 	const CGHeroInstance * hero;
 	TBonusListPtr bonuses;
-	mutable int maxMovePointsLand;
-	mutable int maxMovePointsWater;
+	int maxMovePointsLand;
+	int maxMovePointsWater;
 	int nativeTerrain;
+	/// Movement cost of leaving tile of given terrain over given road with given modifier
+	/// Everything is precomputed on construction so pathfinder only have to do lookups
+	int movementCosts[GameConstants::TERRAIN_TYPES][ROAD_TYPES + 1][COST_MODIFIERS];
 
 	TurnInfo(const CGHeroInstance * Hero, const int Turn = 0);
 	bool isLayerAvailable(const EPathfindingLayer layer) const;
 	bool hasBonusOfType(const Bonus::BonusType type, const int subtype = -1) const;
 	int valOfBonuses(const Bonus::BonusType type, const int subtype = -1) const;
 	int getMaxMovePoints(const EPathfindingLayer layer) const;
+	/// Cost without any layer modifiers. NOT includes diagonal move penalty, last move levelling
+	int getTileCost(const TerrainTile & dest, const TerrainTile & from) const;
+	/// Cost including flying, water walking and favorable winds modifiers
+	int getMovementCost(const TerrainTile & dest, const TerrainTile & from, const bool inBoat) const;
+	/// Cheapest move hero can do on any terrain, road and layer
+	int getMinMovementCost() const;
+
+private:
+	void initMovementCosts();
+	const int * getCosts(const TerrainTile & dest, const TerrainTile & from) const;
 };
 
 class DLL_LINKAGE CPathfinderHelper
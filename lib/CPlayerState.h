@@ -74,6 +74,7 @@ public:
 	std::set<PlayerColor> players; // members of this team
 	//TODO: boost::array, bool if possible
 	std::vector<std::vector<std::vector<ui8> > >  fogOfWarMap; //true - visible, false - hidden
+	ui32 fogOfWarVersion; //changed on every change of fogOfWarMap, not serialized
 
 	TeamState();
 	TeamState(TeamState && other);
@@ -24,14 +24,11 @@ CThreadHelper::CThreadHelper(std::vector<std::function<void()> > *Tasks, int Thr
 }
 void CThreadHelper::run()
 {
+	//threads are owned and deleted by the group
 	boost::thread_group grupa;
-	std::vector<boost::thread *> thr;
 	for(int i=0;i<threads;i++)
-		thr.push_back(grupa.create_thread(std::bind(&CThreadHelper::processTasks,this)));
+		grupa.create_thread(std::bind(&CThreadHelper::processTasks,this));
 	grupa.join_all();
-
-	for(auto thread : thr)
-		delete thread;
 }
 void CThreadHelper::processTasks()
 {
@@ -49,6 +46,86 @@ void CThreadHelper::processTasks()
 	}
 }
 
+CThreadPool::CThreadPool(int Threads)
+	: tasks(nullptr), nextTask(0), unfinishedTasks(0), stopping(false)
+{
+	for(int i = 1; i < Threads; i++)
+		workers.create_thread(std::bind(&CThreadPool::processTasks, this));
+}
+
+CThreadPool::~CThreadPool()
+{
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	workers.join_all();
+}
+
+int CThreadPool::getThreadCount() const
+{
+	return workers.size() + 1;
+}
+
+void CThreadPool::run(std::vector<Task> & Tasks)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	tasks = &Tasks;
+	nextTask = 0;
+	unfinishedTasks = Tasks.size();
+	workAvailable.notify_all();
+
+	while(runNextTask(lock))
+		;
+	while(unfinishedTasks > 0)
+		workDone.wait(lock);
+
+	tasks = nullptr;
+	if(taskError)
+	{
+		std::exception_ptr error = taskError;
+		taskError = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+bool CThreadPool::runNextTask(boost::unique_lock<boost::mutex> & lock)
+{
+	if(!tasks || nextTask >= tasks->size())
+		return false;
+
+	Task & task = (*tasks)[nextTask++];
+	lock.unlock();
+	try
+	{
+		task();
+		lock.lock();
+	}
+	catch(...)
+	{
+		lock.lock();
+		if(!taskError)
+			taskError = std::current_exception();
+	}
+
+	if(--unfinishedTasks == 0)
+		workDone.notify_all();
+	return true;
+}
+
+void CThreadPool::processTasks()
+{
+	setThreadName("CThreadPool::processTasks");
+
+	boost::unique_lock<boost::mutex> lock(mx);
+	while(!stopping)
+	{
+		if(!runNextTask(lock))
+			workAvailable.wait(lock);
+	}
+}
+
 // set name for this thread.
 // NOTE: on *nix string will be trimmed to 16 symbols
 void setThreadName(const std::string &name)
@@ -26,6 +26,30 @@ public:
 	void run();
 };
 
+/// Keeps worker threads alive between runs, so frequent small batches of tasks don't pay for thread creation
+class DLL_LINKAGE CThreadPool : public boost::noncopyable
+{
+	boost::mutex mx;
+	boost::condition_variable workAvailable, workDone;
+	boost::thread_group workers;
+	std::vector<Task> * tasks;
+	size_t nextTask, unfinishedTasks;
+	std::exception_ptr taskError; //first exception thrown by a task of current run
+	bool stopping;
+
+	void processTasks();
+	bool runNextTask(boost::unique_lock<boost::mutex> & lock);
+public:
+	/// creates Threads - 1 workers, calling thread of run() is the last one
+	CThreadPool(int Threads);
+	~CThreadPool();
+
+	int getThreadCount() const;
+	/// executes all tasks and returns once they are finished; must not be called by several threads at once
+	/// if any task throws, remaining tasks still run and the first exception is rethrown to the caller
+	void run(std::vector<Task> & Tasks);
+};
+
 template <typename T> inline void setData(T * data, std::function<T()> func)
 {
 	*data = func();
@@ -64,6 +64,7 @@ void CPrivilagedInfoCallback::getTilesInRange(std::unordered_set<int3, ShashInt3
 	else
 	{
 		const TeamState * team = !player ? nullptr : gs->getPlayerTeam(*player);
+		tiles.reserve(tiles.size() + (2 * radious + 1) * (2 * radious + 1));
 		for (int xd = std::max<int>(pos.x - radious , 0); xd <= std::min<int>(pos.x + radious, gs->map->width - 1); xd++)
 		{
 			for (int yd = std::max<int>(pos.y - radious, 0); yd <= std::min<int>(pos.y + radious, gs->map->height - 1); yd++)
@@ -109,6 +110,7 @@ void CPrivilagedInfoCallback::getAllTiles(std::unordered_set<int3, ShashInt3> &t
 	else
 		floors.push_back(level);
 
+	tiles.reserve(tiles.size() + floors.size() * gs->map->width * gs->map->height);
 	for (auto zd : floors)
 	{
 
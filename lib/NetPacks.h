@@ -330,19 +330,58 @@ struct SetMovePoints : public CPackForClient
 	}
 };
 
+/// Horizontal run of adjacent tiles, used to transfer big sets of tiles in compact form
+struct DLL_LINKAGE TileRun
+{
+	int3 start;
+	si32 length;
+
+	TileRun() : length(0) {}
+	TileRun(const int3 & start, si32 length) : start(start), length(length) {}
+
+	/// no row of any map is longer, used when size of map is not known
+	static const si32 MAX_LENGTH = 1024;
+
+	static std::vector<TileRun> fromTiles(const std::unordered_set<int3, ShashInt3> & tiles);
+	static void toTiles(const std::vector<TileRun> & runs, std::unordered_set<int3, ShashInt3> & tiles);
+	/// throws if any run is empty or does not fit into map of given size; map size of zero is checked only against MAX_LENGTH
+	static void validate(const std::vector<TileRun> & runs, const int3 & mapSize);
+
+	template <typename Handler> void serialize(Handler &h, const int version)
+	{
+		h & start;
+		h & length;
+	}
+};
+
 struct FoWChange : public CPackForClient
 {
 	FoWChange(){mode = 0; waitForDialogs = false;}
 	void applyCl(CClient *cl);
 	DLL_LINKAGE void applyGs(CGameState *gs);
 
-	std::unordered_set<int3, struct ShashInt3 > tiles;
+	std::unordered_set<int3, struct ShashInt3 > tiles; //separate tiles, sent as runs
+	std::vector<TileRun> runs; //rows filled directly by big reveals, received tiles are always here
 	PlayerColor player;
 	ui8 mode; //mode==0 - hide, mode==1 - reveal
 	bool waitForDialogs;
 	template <typename Handler> void serialize(Handler &h, const int version)
 	{
-		h & tiles;
+		//revealed areas are mostly continuous, whole map is sent as one run per row
+		if(h.saving && !tiles.empty())
+		{
+			std::vector<TileRun> all = runs;
+			auto separate = TileRun::fromTiles(tiles);
+			all.insert(all.end(), separate.begin(), separate.end());
+			h & all;
+		}
+		else
+			h & runs;
+		if(!h.saving)
+		{
+			TileRun::validate(runs, h.getMapSize());
+			tiles.clear();
+		}
 		h & player;
 		h & mode;
 		h & waitForDialogs;
@@ -2021,6 +2060,21 @@ struct MoveHero : public CPackForServer
 	}
 };
 
+struct MoveHeroPath : public CPackForServer
+{
+	MoveHeroPath(){};
+	MoveHeroPath(ObjectInstanceID HID, const std::vector<std::pair<int3, bool>> & Steps) : hid(HID), steps(Steps) {};
+	ObjectInstanceID hid;
+	std::vector<std::pair<int3, bool>> steps; //consecutive neighbouring tiles (h3m format) and transit flag for each of them
+
+	bool applyGh(CGameHandler *gh);
+	template <typename Handler> void serialize(Handler &h, const int version)
+	{
+		h & hid;
+		h & steps;
+	}
+};
+
 struct CastleTeleportHero : public CPackForServer
 {
 	CastleTeleportHero():source(0){};
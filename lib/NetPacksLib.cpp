@@ -39,6 +39,7 @@ std::ostream & operator<<(std::ostream & out, const CPack * pack)
 
 DLL_LINKAGE void SetResources::applyGs(CGameState *gs)
 {
+	gs->journal.recordPlayer(player);
 	assert(player < PlayerColor::PLAYER_LIMIT);
 	if(abs)
 		gs->getPlayer(player)->resources = res;
@@ -56,12 +57,16 @@ DLL_LINKAGE void SetPrimSkill::applyGs(CGameState *gs)
 	CGHeroInstance * hero = gs->getHero(id);
 	assert(hero);
 	hero->setPrimarySkill(which, val, abs);
+	gs->journal.recordObject(id);
+	gs->journal.recordBonuses(id);
 }
 
 DLL_LINKAGE void SetSecSkill::applyGs(CGameState *gs)
 {
 	CGHeroInstance *hero = gs->getHero(id);
 	hero->setSecSkillLevel(which, val, abs);
+	gs->journal.recordObject(id);
+	gs->journal.recordBonuses(id);
 }
 
 DLL_LINKAGE SelectMap::SelectMap(const CMapInfo &src)
@@ -102,6 +107,8 @@ DLL_LINKAGE void SetCommanderProperty::applyGs(CGameState *gs)
 {
 	CCommanderInstance * commander = gs->getHero(heroid)->commander;
 	assert (commander);
+	gs->journal.recordObject(heroid);
+	gs->journal.recordBonuses(heroid);
 
 	switch (which)
 	{
@@ -160,6 +167,7 @@ DLL_LINKAGE void UpdateCastleEvents::applyGs(CGameState *gs)
 DLL_LINKAGE void ChangeFormation::applyGs(CGameState *gs)
 {
 	gs->getHero(hid)->setFormation(formation);
+	gs->journal.recordObject(hid);
 }
 
 DLL_LINKAGE void HeroVisitCastle::applyGs(CGameState *gs)
@@ -169,6 +177,8 @@ DLL_LINKAGE void HeroVisitCastle::applyGs(CGameState *gs)
 
 	assert(h);
 	assert(t);
+	gs->journal.recordObject(hid);
+	gs->journal.recordObject(tid);
 
 	if(start())
 		t->setVisitingHero(h);
@@ -179,6 +189,7 @@ DLL_LINKAGE void HeroVisitCastle::applyGs(CGameState *gs)
 DLL_LINKAGE void ChangeSpells::applyGs(CGameState *gs)
 {
 	CGHeroInstance *hero = gs->getHero(hid);
+	gs->journal.recordObject(hid);
 
 	if(learn)
 		for(auto sid : spells)
@@ -200,6 +211,7 @@ DLL_LINKAGE void SetMana::applyGs(CGameState *gs)
 		hero->mana += val;
 
 	vstd::amax(hero->mana, 0); //not less than 0
+	gs->journal.recordObject(hid);
 }
 
 DLL_LINKAGE void SetMovePoints::applyGs(CGameState *gs)
@@ -214,13 +226,75 @@ DLL_LINKAGE void SetMovePoints::applyGs(CGameState *gs)
 		hero->movement += val;
 
 	vstd::amax(hero->movement, 0); //not less than 0
+	gs->journal.recordObject(hid);
+}
+
+std::vector<TileRun> TileRun::fromTiles(const std::unordered_set<int3, ShashInt3> & tiles)
+{
+	std::vector<int3> sorted(tiles.begin(), tiles.end());
+	boost::sort(sorted); //by level, row and column
+
+	std::vector<TileRun> runs;
+	for(const int3 & tile : sorted)
+	{
+		if(!runs.empty())
+		{
+			TileRun & last = runs.back();
+			if(last.start.z == tile.z && last.start.y == tile.y && last.start.x + last.length == tile.x)
+			{
+				last.length++;
+				continue;
+			}
+		}
+		runs.push_back(TileRun(tile, 1));
+	}
+	return runs;
+}
+
+void TileRun::toTiles(const std::vector<TileRun> & runs, std::unordered_set<int3, ShashInt3> & tiles)
+{
+	size_t count = tiles.size();
+	for(const TileRun & run : runs)
+		count += run.length;
+	tiles.reserve(count);
+
+	for(const TileRun & run : runs)
+	{
+		for(int i = 0; i < run.length; i++)
+			tiles.insert(int3(run.start.x + i, run.start.y, run.start.z));
+	}
+}
+
+void TileRun::validate(const std::vector<TileRun> & runs, const int3 & mapSize)
+{
+	const bool checkMap = mapSize != int3();
+	for(const TileRun & run : runs)
+	{
+		//compared in 64 bits, so huge length does not overflow
+		const si64 end = static_cast<si64>(run.start.x) + run.length;
+		if(run.length <= 0 || run.start.x < 0 || run.start.y < 0 || run.start.z < 0 || end > MAX_LENGTH)
+			throw std::runtime_error("Corrupted stream: invalid tile run of length " + std::to_string(run.length) + " at " + run.start.toString());
+		if(checkMap && (end > mapSize.x || run.start.y >= mapSize.y || run.start.z >= mapSize.z))
+			throw std::runtime_error("Corrupted stream: tile run of length " + std::to_string(run.length) + " at " + run.start.toString() + " is outside of the map");
+	}
 }
 
 DLL_LINKAGE void FoWChange::applyGs(CGameState *gs)
 {
 	TeamState * team = gs->getPlayerTeam(player);
+	team->fogOfWarVersion++;
+	auto & fow = team->fogOfWarMap;
 	for(int3 t : tiles)
-		team->fogOfWarMap[t.x][t.y][t.z] = mode;
+		fow[t.x][t.y][t.z] = mode;
+	for(const TileRun & run : runs)
+	{
+		for(int i = 0; i < run.length; i++)
+			fow[run.start.x + i][run.start.y][run.start.z] = mode;
+	}
+	gs->journal.recordTiles(tiles);
+	gs->journal.recordTiles(runs);
+	for(auto & color : team->players)
+		gs->journal.recordPlayer(color);
 	if (mode == 0) //do not hide too much
 	{
 		std::unordered_set<int3, ShashInt3> tilesRevealed;
@@ -250,6 +324,7 @@ DLL_LINKAGE void SetAvailableHeroes::applyGs(CGameState *gs)
 {
 	PlayerState *p = gs->getPlayer(player);
 	p->availableHeroes.clear();
+	gs->journal.recordPlayer(player);
 
 	for (int i = 0; i < GameConstants::AVAILABLE_HEROES_PER_PLAYER; i++)
 	{
@@ -283,6 +358,13 @@ DLL_LINKAGE void GiveBonus::applyGs(CGameState *gs)
 
 	auto b = std::make_shared<Bonus>(bonus);
 	cbsn->addNewBonus(b);
+	if(who == PLAYER)
+		gs->journal.recordPlayer(PlayerColor(id));
+	else
+	{
+		gs->journal.recordObject(ObjectInstanceID(id));
+		gs->journal.recordBonuses(ObjectInstanceID(id));
+	}
 
 	std::string &descr = b->description;
 
@@ -309,13 +391,17 @@ DLL_LINKAGE void ChangeObjPos::applyGs(CGameState *gs)
 		logNetwork->error("Wrong ChangeObjPos: object %d doesn't exist!", objid.getNum());
 		return;
 	}
+	gs->journal.recordObject(obj);
 	gs->map->removeBlockVisTiles(obj);
 	obj->pos = nPos;
 	gs->map->addBlockVisTiles(obj);
+	gs->journal.recordObject(obj);
 }
 
 DLL_LINKAGE void ChangeObjectVisitors::applyGs(CGameState *gs)
 {
+	gs->journal.recordObject(object);
+	gs->journal.recordObject(hero);
 	switch (mode) {
 		case VISITOR_ADD:
 			gs->getHero(hero)->visitedObjects.insert(object);
@@ -354,6 +440,7 @@ DLL_LINKAGE void ChangeObjectVisitors::applyGs(CGameState *gs)
 DLL_LINKAGE void PlayerEndsGame::applyGs(CGameState *gs)
 {
 	PlayerState *p = gs->getPlayer(player);
+	gs->journal.recordPlayer(player);
 	if(victoryLossCheckResult.victory()) p->status = EPlayerStatus::WINNER;
 	else p->status = EPlayerStatus::LOSER;
 }
@@ -365,6 +452,10 @@ DLL_LINKAGE void RemoveBonus::applyGs(CGameState *gs)
 		node = gs->getHero(ObjectInstanceID(whoID));
 	else
 		node = gs->getPlayer(PlayerColor(whoID));
+	if(who == HERO)
+		gs->journal.recordBonuses(ObjectInstanceID(whoID));
+	else
+		gs->journal.recordPlayer(PlayerColor(whoID));
 
 	BonusList &bonuses = node->getExportedBonusList();
 
@@ -385,6 +476,8 @@ DLL_LINKAGE void RemoveObject::applyGs(CGameState *gs)
 
 	CGObjectInstance *obj = gs->getObjInstance(id);
 	logGlobal->debug("removing object id=%d; address=%x; name=%s", id, (intptr_t)obj, obj->getObjectName());
+	gs->journal.recordObject(obj);
+	gs->journal.recordPlayer(obj->tempOwner);
 	//unblock tiles
 	gs->map->removeBlockVisTiles(obj);
 
@@ -518,6 +611,7 @@ void TryMoveHero::applyGs(CGameState *gs)
 	}
 
 	h->movement = movePoints;
+	gs->journal.recordObject(h);
 
 	if((result == SUCCESS || result == BLOCKING_VISIT || result == EMBARK || result == DISEMBARK) && start != end)
 	{
@@ -532,6 +626,7 @@ void TryMoveHero::applyGs(CGameState *gs)
 		const TerrainTile &tt = gs->map->getTile(CGHeroInstance::convertPosition(end, false));
 		assert(tt.visitableObjects.size() >= 1  &&  tt.visitableObjects.back()->ID == Obj::BOAT); //the only visitable object at destination is Boat
 		CGBoat *boat = static_cast<CGBoat*>(tt.visitableObjects.back());
+		gs->journal.recordObject(boat);
 
 		gs->map->removeBlockVisTiles(boat); //hero blockvis mask will be used, we don't need to duplicate it with boat
 		h->boat = boat;
@@ -544,6 +639,7 @@ void TryMoveHero::applyGs(CGameState *gs)
 		b->pos = start;
 		b->hero = nullptr;
 		gs->map->addBlockVisTiles(b);
+		gs->journal.recordObject(b);
 		h->boat = nullptr;
 	}
 
@@ -554,10 +650,17 @@ void TryMoveHero::applyGs(CGameState *gs)
 		if(CGBoat *b = const_cast<CGBoat *>(h->boat))
 			b->pos = end;
 		gs->map->addBlockVisTiles(h);
+		gs->journal.recordObject(h);
 	}
 
+	TeamState * team = gs->getPlayerTeam(h->getOwner());
+	if(!fowRevealed.empty())
+	{
+		team->fogOfWarVersion++;
+		gs->journal.recordTiles(fowRevealed);
+	}
 	for(int3 t : fowRevealed)
-		gs->getPlayerTeam(h->getOwner())->fogOfWarMap[t.x][t.y][t.z] = 1;
+		team->fogOfWarMap[t.x][t.y][t.z] = 1;
 }
 
 DLL_LINKAGE void NewStructures::applyGs(CGameState *gs)
@@ -572,6 +675,8 @@ DLL_LINKAGE void NewStructures::applyGs(CGameState *gs)
 	}
 	t->builded = builded;
 	t->recreateBuildingsBonuses();
+	gs->journal.recordObject(t);
+	gs->journal.recordBonuses(t->id);
 }
 DLL_LINKAGE void RazeStructures::applyGs(CGameState *gs)
 {
@@ -584,6 +689,8 @@ DLL_LINKAGE void RazeStructures::applyGs(CGameState *gs)
 	}
 	t->destroyed = destroyed; //yeaha
 	t->recreateBuildingsBonuses();
+	gs->journal.recordObject(t);
+	gs->journal.recordBonuses(t->id);
 }
 
 DLL_LINKAGE void SetAvailableCreatures::applyGs(CGameState *gs)
@@ -591,6 +698,7 @@ DLL_LINKAGE void SetAvailableCreatures::applyGs(CGameState *gs)
 	CGDwelling *dw = dynamic_cast<CGDwelling*>(gs->getObjInstance(tid));
 	assert(dw);
 	dw->creatures = creatures;
+	gs->journal.recordObject(tid);
 }
 
 DLL_LINKAGE void SetHeroesInTown::applyGs(CGameState *gs)
@@ -600,6 +708,10 @@ DLL_LINKAGE void SetHeroesInTown::applyGs(CGameState *gs)
 	CGHeroInstance *v  = gs->getHero(visiting),
 		*g = gs->getHero(garrison);
 
+	gs->journal.recordObject(t);
+	gs->journal.recordObject(visiting);
+	gs->journal.recordObject(garrison);
+
 	bool newVisitorComesFromGarrison = v && v == t->garrisonHero;
 	bool newGarrisonComesFromVisiting = g && g == t->visitingHero;
 
@@ -656,10 +768,13 @@ DLL_LINKAGE void HeroRecruited::applyGs(CGameState *gs)
 		h->initObj(gs->getRandomGenerator());
 	}
 	gs->map->addBlockVisTiles(h);
+	gs->journal.recordObject(h);
+	gs->journal.recordPlayer(player);
 
 	if(t)
 	{
 		t->setVisitingHero(h);
+		gs->journal.recordObject(t);
 	}
 }
 
@@ -679,6 +794,8 @@ DLL_LINKAGE void GiveHero::applyGs(CGameState *gs)
 	gs->getPlayer(h->getOwner())->heroes.push_back(h);
 	gs->map->addBlockVisTiles(h);
 	h->inTownGarrison = false;
+	gs->journal.recordObject(h);
+	gs->journal.recordPlayer(player);
 }
 
 DLL_LINKAGE void NewObject::applyGs(CGameState *gs)
@@ -720,6 +837,7 @@ DLL_LINKAGE void NewObject::applyGs(CGameState *gs)
 	gs->map->addBlockVisTiles(o);
 	o->initObj(gs->getRandomGenerator());
 	gs->map->calculateGuardingGreaturePositions();
+	gs->journal.recordObject(o);
 
 	logGlobal->debug("Added object id=%d; address=%x; name=%s", id, (intptr_t)o, o->getObjectName());
 }
@@ -840,16 +958,19 @@ DLL_LINKAGE void ChangeStackCount::applyGs(CGameState *gs)
 		sl.army->setStackCount(sl.slot, count);
 	else
 		sl.army->changeStackCount(sl.slot, count);
+	gs->journal.recordObject(sl.army->id);
 }
 
 DLL_LINKAGE void SetStackType::applyGs(CGameState *gs)
 {
 	sl.army->setStackType(sl.slot, type);
+	gs->journal.recordObject(sl.army->id);
 }
 
 DLL_LINKAGE void EraseStack::applyGs(CGameState *gs)
 {
 	sl.army->eraseStack(sl.slot);
+	gs->journal.recordObject(sl.army->id);
 }
 
 DLL_LINKAGE void SwapStacks::applyGs(CGameState *gs)
@@ -859,18 +980,23 @@ DLL_LINKAGE void SwapStacks::applyGs(CGameState *gs)
 
 	sl2.army->putStack(sl2.slot, s1);
 	sl1.army->putStack(sl1.slot, s2);
+	gs->journal.recordObject(sl1.army->id);
+	gs->journal.recordObject(sl2.army->id);
 }
 
 DLL_LINKAGE void InsertNewStack::applyGs(CGameState *gs)
 {
 	auto s = new CStackInstance(stack.type, stack.count);
 	sl.army->putStack(sl.slot, s);
+	gs->journal.recordObject(sl.army->id);
 }
 
 DLL_LINKAGE void RebalanceStacks::applyGs(CGameState *gs)
 {
 	const CCreature *srcType = src.army->getCreature(src.slot);
 	TQuantity srcCount = src.army->getStackCount(src.slot);
+	gs->journal.recordObject(src.army->id);
+	gs->journal.recordObject(dst.army->id);
 	bool stackExp = VLC->modh->modules.STACK_EXP;
 
 	if(srcCount == count) //moving whole stack
@@ -1165,6 +1291,7 @@ DLL_LINKAGE void SetObjectProperty::applyGs(CGameState *gs)
 		logNetwork->error("Wrong object ID - property cannot be set!");
 		return;
 	}
+	gs->journal.recordObject(obj);
 
 	CArmedInstance *cai = dynamic_cast<CArmedInstance *>(obj);
 	if(what == ObjProperty::OWNER && cai)
@@ -1187,8 +1314,11 @@ DLL_LINKAGE void SetObjectProperty::applyGs(CGameState *gs)
 
 		CBonusSystemNode *nodeToMove = cai->whatShouldBeAttached();
 		nodeToMove->detachFrom(cai->whereShouldBeAttached(gs));
+		gs->journal.recordPlayer(obj->tempOwner);
 		obj->setProperty(what,val);
 		nodeToMove->attachTo(cai->whereShouldBeAttached(gs));
+		gs->journal.recordPlayer(obj->tempOwner);
+		gs->journal.recordBonuses(obj->id);
 	}
 	else //not an armed instance
 	{
@@ -1200,6 +1330,7 @@ DLL_LINKAGE void PrepareHeroLevelUp::applyGs(CGameState *gs)
 {
 	CGHeroInstance * h = gs->getHero(hero->id);
 	auto proposedSkills = h->getLevelUpProposedSecondarySkills();
+	gs->journal.recordObject(h->id);
 
 	if(skills.size() == 1 || hero->tempOwner == PlayerColor::NEUTRAL) //choose skill automatically
 	{
@@ -1215,6 +1346,8 @@ DLL_LINKAGE void HeroLevelUp::applyGs(CGameState *gs)
 {
 	CGHeroInstance * h = gs->getHero(hero->id);
 	h->levelUp(skills);
+	gs->journal.recordObject(h->id);
+	gs->journal.recordBonuses(h->id);
 }
 
 DLL_LINKAGE void CommanderLevelUp::applyGs (CGameState *gs)
@@ -1222,6 +1355,8 @@ DLL_LINKAGE void CommanderLevelUp::applyGs (CGameState *gs)
 	CCommanderInstance * commander = gs->getHero(hero->id)->commander;
 	assert (commander);
 	commander->levelUp();
+	gs->journal.recordObject(hero->id);
+	gs->journal.recordBonuses(hero->id);
 }
 
 DLL_LINKAGE void BattleStart::applyGs(CGameState *gs)
@@ -1855,11 +1990,13 @@ DLL_LINKAGE void PlayerCheated::applyGs(CGameState *gs)
 
 	gs->getPlayer(player)->enteredLosingCheatCode = losingCheatCode;
 	gs->getPlayer(player)->enteredWinningCheatCode = winningCheatCode;
+	gs->journal.recordPlayer(player);
 }
 
 DLL_LINKAGE void YourTurn::applyGs(CGameState *gs)
 {
 	gs->currentPlayer = player;
+	gs->journal.recordPlayer(player);
 
 	auto & playerState = gs->players[player];
 	playerState.daysWithoutCastle = daysWithoutCastle;
@@ -58,6 +58,16 @@ si64 CBufferedStream::getSize()
 	return size;
 }
 
+std::vector<ui8> CBufferedStream::releaseData()
+{
+	ensureSize(std::numeric_limits<si64>::max());
+
+	std::vector<ui8> data;
+	data.swap(buffer);
+	position = 0;
+	return data;
+}
+
 void CBufferedStream::ensureSize(si64 size)
 {
 	while (buffer.size() < size && !endOfFileReached)
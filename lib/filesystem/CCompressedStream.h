@@ -63,6 +63,14 @@ public:
 	 */
 	si64 getSize() override;
 
+	/**
+	 * Decompresses the whole stream and moves its data out without copying.
+	 * The stream is empty afterwards.
+	 *
+	 * @return all data of the stream.
+	 */
+	std::vector<ui8> releaseData();
+
 protected:
 	/**
 	 * @brief virtual method to get more data into the buffer
@@ -62,36 +62,8 @@ static int lowestSpeed(const CGHeroInstance * chi)
 
 ui32 CGHeroInstance::getTileCost(const TerrainTile &dest, const TerrainTile &from, const TurnInfo * ti) const
 {
-	unsigned ret = GameConstants::BASE_MOVEMENT_COST;
-
-	//if there is road both on dest and src tiles - use road movement cost
-	if(dest.roadType != ERoadType::NO_ROAD && from.roadType != ERoadType::NO_ROAD)
-	{
-		int road = std::min(dest.roadType,from.roadType); //used road ID
-		switch(road)
-		{
-		case ERoadType::DIRT_ROAD:
-			ret = 75;
-			break;
-		case ERoadType::GRAVEL_ROAD:
-			ret = 65;
-			break;
-		case ERoadType::COBBLESTONE_ROAD:
-			ret = 50;
-			break;
-		default:
-			logGlobal->error("Unknown road type: %d", road);
-			break;
-		}
-	}
-	else if(ti->nativeTerrain != from.terType && !ti->hasBonusOfType(Bonus::NO_TERRAIN_PENALTY, from.terType))
-	{
-		ret = VLC->heroh->terrCosts[from.terType];
-		ret -= valOfBonuses(Selector::typeSubtype(Bonus::SECONDARY_SKILL_PREMY, SecondarySkill::PATHFINDING));
-		if(ret < GameConstants::BASE_MOVEMENT_COST)
-			ret = GameConstants::BASE_MOVEMENT_COST;
-	}
-	return ret;
+	assert(ti);
+	return ti->getTileCost(dest, from);
 }
 
 int CGHeroInstance::getNativeTerrain() const
@@ -236,8 +236,7 @@ CMapHeader::~CMapHeader()
 }
 
 CMap::CMap()
-	: checksum(0), grailPos(-1, -1, -1), grailRadius(0), terrain(nullptr),
-	guardingCreaturePositions(nullptr)
+	: checksum(0), grailPos(-1, -1, -1), grailRadius(0)
 {
 	allHeroes.resize(allowedHeroes.size());
 	allowedAbilities = VLC->heroh->getDefaultAllowedAbilities();
@@ -247,22 +246,6 @@ CMap::CMap()
 
 CMap::~CMap()
 {
-	if(terrain)
-	{
-		for (int i=0; i<width; i++)
-		{
-			for(int j=0; j<height; j++)
-			{
-				delete [] terrain[i][j];
-				delete [] guardingCreaturePositions[i][j];
-			}
-			delete [] terrain[i];
-			delete [] guardingCreaturePositions[i];
-		}
-		delete [] terrain;
-		delete [] guardingCreaturePositions;
-	}
-
 	for(auto obj : objects)
 		obj.dellNull();
 
@@ -272,6 +255,7 @@ CMap::~CMap()
 
 void CMap::removeBlockVisTiles(CGObjectInstance * obj, bool total)
 {
+	unindexObject(obj);
 	for(int fx=0; fx<obj->getWidth(); ++fx)
 	{
 		for(int fy=0; fy<obj->getHeight(); ++fy)
@@ -281,7 +265,7 @@ void CMap::removeBlockVisTiles(CGObjectInstance * obj, bool total)
 			int zVal = obj->pos.z;
 			if(xVal>=0 && xVal<width && yVal>=0 && yVal<height)
 			{
-				TerrainTile & curt = terrain[xVal][yVal][zVal];
+				TerrainTile & curt = getTile(int3(xVal, yVal, zVal));
 				if(total || obj->visitableAt(xVal, yVal))
 				{
 					curt.visitableObjects -= obj;
@@ -299,6 +283,7 @@ void CMap::removeBlockVisTiles(CGObjectInstance * obj, bool total)
 
 void CMap::addBlockVisTiles(CGObjectInstance * obj)
 {
+	indexObject(obj);
 	for(int fx=0; fx<obj->getWidth(); ++fx)
 	{
 		for(int fy=0; fy<obj->getHeight(); ++fy)
@@ -308,7 +293,7 @@ void CMap::addBlockVisTiles(CGObjectInstance * obj)
 			int zVal = obj->pos.z;
 			if(xVal>=0 && xVal<width && yVal>=0 && yVal<height)
 			{
-				TerrainTile & curt = terrain[xVal][yVal][zVal];
+				TerrainTile & curt = getTile(int3(xVal, yVal, zVal));
 				if( obj->visitableAt(xVal, yVal))
 				{
 					curt.visitableObjects.push_back(obj);
@@ -324,6 +309,99 @@ void CMap::addBlockVisTiles(CGObjectInstance * obj)
 	}
 }
 
+size_t CMap::getObjectBucket(const int3 & pos) const
+{
+	const int bucketsX = (width + OBJECT_BUCKET_SIZE - 1) / OBJECT_BUCKET_SIZE;
+	const int bucketsY = (height + OBJECT_BUCKET_SIZE - 1) / OBJECT_BUCKET_SIZE;
+	//query area may stick out of the map, it is clamped to the nearest bucket
+	const int x = std::min(std::max(pos.x, 0), width - 1) / OBJECT_BUCKET_SIZE;
+	const int y = std::min(std::max(pos.y, 0), height - 1) / OBJECT_BUCKET_SIZE;
+	const int z = std::min(std::max(pos.z, 0), twoLevel ? 1 : 0);
+	return (z * bucketsY + y) * bucketsX + x;
+}
+
+void CMap::indexObject(CGObjectInstance * obj)
+{
+	if(objectBuckets.empty())
+	{
+		const int bucketsX = (width + OBJECT_BUCKET_SIZE - 1) / OBJECT_BUCKET_SIZE;
+		const int bucketsY = (height + OBJECT_BUCKET_SIZE - 1) / OBJECT_BUCKET_SIZE;
+		objectBuckets.resize(bucketsX * bucketsY * (twoLevel ? 2 : 1));
+	}
+
+	unindexObject(obj);
+	//obstacles and other decorations are never looked up by range
+	//objects visitable outside of the map are not in tile lists either, so they would be lost on rebuild
+	if(!obj->isVisitable() || !isInTheMap(obj->visitablePos()))
+		return;
+
+	size_t bucket = getObjectBucket(obj->visitablePos());
+	objectBuckets[bucket].push_back(obj);
+	objectBucketOf[obj] = bucket;
+}
+
+void CMap::unindexObject(const CGObjectInstance * obj)
+{
+	auto it = objectBucketOf.find(obj);
+	if(it == objectBucketOf.end())
+		return;
+
+	vstd::erase_if_present(objectBuckets[it->second], obj);
+	objectBucketOf.erase(it);
+}
+
+void CMap::rebuildObjectIndex()
+{
+	objectBuckets.clear();
+	objectBucketOf.clear();
+
+	int levels = twoLevel ? 2 : 1;
+	for(int i = 0; i < width; i++)
+	{
+		for(int j = 0; j < height; j++)
+		{
+			for(int k = 0; k < levels; k++)
+			{
+				const TerrainTile & tile = getTile(int3(i, j, k));
+				for(auto obj : tile.visitableObjects)
+				{
+					if(!vstd::contains(objectBucketOf, obj))
+						indexObject(obj);
+				}
+			}
+		}
+	}
+}
+
+std::vector<CGObjectInstance *> CMap::getObjectsInRange(const int3 & pos, int radius, Obj type) const
+{
+	std::vector<CGObjectInstance *> ret;
+	if(objectBuckets.empty() || radius < 0)
+		return ret;
+
+	const int bucketsX = (width + OBJECT_BUCKET_SIZE - 1) / OBJECT_BUCKET_SIZE;
+	const size_t first = getObjectBucket(int3(pos.x - radius, pos.y - radius, pos.z));
+	const size_t last = getObjectBucket(int3(pos.x + radius, pos.y + radius, pos.z));
+	const size_t rows = (last - first) / bucketsX + 1;
+	const size_t columns = (last - first) % bucketsX + 1;
+
+	for(size_t row = 0; row < rows; row++)
+	{
+		for(size_t column = 0; column < columns; column++)
+		{
+			for(CGObjectInstance * obj : objectBuckets[first + row * bucketsX + column])
+			{
+				if(type != Obj::NO_OBJ && obj->ID != type)
+					continue;
+				int3 objPos = obj->visitablePos();
+				if(objPos.z == pos.z && std::abs(objPos.x - pos.x) <= radius && std::abs(objPos.y - pos.y) <= radius)
+					ret.push_back(obj);
+			}
+		}
+	}
+	return ret;
+}
+
 void CMap::calculateGuardingGreaturePositions()
 {
 	int levels = twoLevel ? 2 : 1;
@@ -332,7 +410,7 @@ void CMap::calculateGuardingGreaturePositions()
 		for(int j=0; j<height; j++)
 		{
 			for (int k = 0; k < levels; k++)
-				guardingCreaturePositions[i][j][k] = guardingCreaturePosition(int3(i,j,k));
+				guardingCreaturePositions[getTileIndex(int3(i, j, k))] = guardingCreaturePosition(int3(i,j,k));
 		}
 	}
 }
@@ -387,18 +465,6 @@ bool CMap::isInTheMap(const int3 & pos) const
 	}
 }
 
-TerrainTile & CMap::getTile(const int3 & tile)
-{
-	assert(isInTheMap(tile));
-	return terrain[tile.x][tile.y][tile.z];
-}
-
-const TerrainTile & CMap::getTile(const int3 & tile) const
-{
-	assert(isInTheMap(tile));
-	return terrain[tile.x][tile.y][tile.z];
-}
-
 bool CMap::isWaterTile(const int3 &pos) const
 {
 	return isInTheMap(pos) && getTile(pos).isWater();
@@ -627,18 +693,10 @@ void CMap::addNewObject(CGObjectInstance * obj)
 void CMap::initTerrain()
 {
 	int level = twoLevel ? 2 : 1;
-	terrain = new TerrainTile**[width];
-	guardingCreaturePositions = new int3**[width];
-	for (int i = 0; i < width; ++i)
-	{
-		terrain[i] = new TerrainTile*[height];
-		guardingCreaturePositions[i] = new int3*[height];
-		for (int j = 0; j < height; ++j)
-		{
-			terrain[i][j] = new TerrainTile[level];
-			guardingCreaturePositions[i][j] = new int3[level];
-		}
-	}
+	terrain.clear();
+	terrain.resize(width * height * level);
+	guardingCreaturePositions.clear();
+	guardingCreaturePositions.resize(width * height * level);
 }
 
 CMapEditManager * CMap::getEditManager()
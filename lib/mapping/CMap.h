@@ -352,8 +352,21 @@ public:
 	void initTerrain();
 
 	CMapEditManager * getEditManager();
-	TerrainTile & getTile(const int3 & tile);
-	const TerrainTile & getTile(const int3 & tile) const;
+	TerrainTile & getTile(const int3 & tile)
+	{
+		assert(isInTheMap(tile));
+		return terrain[getTileIndex(tile)];
+	}
+	const TerrainTile & getTile(const int3 & tile) const
+	{
+		assert(isInTheMap(tile));
+		return terrain[getTileIndex(tile)];
+	}
+	/// Index of the tile in contiguous per-tile arrays, tiles are stored level by level and row by row
+	size_t getTileIndex(const int3 & tile) const
+	{
+		return (static_cast<size_t>(tile.z) * height + tile.y) * width + tile.x;
+	}
 	bool isCoastalTile(const int3 & pos) const;
 	bool isInTheMap(const int3 & pos) const;
 	bool isWaterTile(const int3 & pos) const;
@@ -366,6 +379,10 @@ public:
 	void removeBlockVisTiles(CGObjectInstance * obj, bool total = false);
 	void calculateGuardingGreaturePositions();
 
+	/// Gets visitable objects placed on map with visitable position in square area around given position, in no particular order.
+	/// Cost depends on the size of the area and not on the number of objects on the map. NO_OBJ type gets objects of all types.
+	std::vector<CGObjectInstance *> getObjectsInRange(const int3 & pos, int radius, Obj type = Obj::NO_OBJ) const;
+
 	void addNewArtifactInstance(CArtifactInstance * art);
 	void eraseArtifactInstance(CArtifactInstance * art);
 
@@ -408,13 +425,23 @@ public:
 
 	std::unique_ptr<CMapEditManager> editManager;
 
-	int3 ***guardingCreaturePositions;
+	std::vector<int3> guardingCreaturePositions; //indexed by getTileIndex
 
 	std::map<std::string, ConstTransitivePtr<CGObjectInstance> > instanceNames;
 
 private:
-	/// a 3-dimensional array of terrain tiles, access is as follows: x, y, level. where level=1 is underground
-	TerrainTile*** terrain;
+	/// terrain tiles of all levels in one block, indexed by getTileIndex. level=1 is underground
+	std::vector<TerrainTile> terrain;
+
+	/// Spatial index of visitable objects on map, maintained by addBlockVisTiles and removeBlockVisTiles
+	static const int OBJECT_BUCKET_SIZE = 8;
+	std::vector<std::vector<CGObjectInstance *>> objectBuckets;
+	std::unordered_map<const CGObjectInstance *, size_t> objectBucketOf;
+
+	size_t getObjectBucket(const int3 & pos) const;
+	void indexObject(CGObjectInstance * obj);
+	void unindexObject(const CGObjectInstance * obj);
+	void rebuildObjectIndex();
 
 public:
 	template <typename Handler>
@@ -434,45 +461,22 @@ public:
 
 		//TODO: viccondetails
 		int level = twoLevel ? 2 : 1;
-		if(h.saving)
+		if(!h.saving)
 		{
-			// Save terrain
-			for(int i = 0; i < width ; ++i)
-			{
-				for(int j = 0; j < height ; ++j)
-				{
-					for(int k = 0; k < level; ++k)
-					{
-						h & terrain[i][j][k];
-						h & guardingCreaturePositions[i][j][k];
-					}
-				}
-			}
+			terrain.clear();
+			terrain.resize(width * height * level);
+			guardingCreaturePositions.resize(width * height * level);
 		}
-		else
+		// terrain is serialized in the original x, y, level order
+		for(int i = 0; i < width ; ++i)
 		{
-			// Load terrain
-			terrain = new TerrainTile**[width];
-			guardingCreaturePositions = new int3**[width];
-			for(int i = 0; i < width; ++i)
+			for(int j = 0; j < height ; ++j)
 			{
-				terrain[i] = new TerrainTile*[height];
-				guardingCreaturePositions[i] = new int3*[height];
-				for(int j = 0; j < height; ++j)
+				for(int k = 0; k < level; ++k)
 				{
-					terrain[i][j] = new TerrainTile[level];
-					guardingCreaturePositions[i][j] = new int3[level];
-				}
-			}
-			for(int i = 0; i < width ; ++i)
-			{
-				for(int j = 0; j < height ; ++j)
-				{
-					for(int k = 0; k < level; ++k)
-					{
-						h & terrain[i][j][k];
-						h & guardingCreaturePositions[i][j][k];
-					}
+					size_t index = getTileIndex(int3(i, j, k));
+					h & terrain[index];
+					h & guardingCreaturePositions[index];
 				}
 			}
 		}
@@ -495,5 +499,8 @@ public:
 		{
 			h & instanceNames;
 		}
+
+		if(!h.saving)
+			rebuildObjectIndex();
 	}
 };
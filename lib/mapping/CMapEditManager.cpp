@@ -15,6 +15,7 @@
 #include "../mapObjects/CObjectClassesHandler.h"
 #include "../mapObjects/CGHeroInstance.h"
 #include "../VCMI_Lib.h"
+#include "../CThreadHelper.h"
 #include "CDrawRoadsOperation.h"
 #include "../mapping/CMap.h"
 
@@ -228,7 +229,7 @@ const CMapOperation * CMapUndoManager::peek(const TStack & stack) const
 }
 
 CMapEditManager::CMapEditManager(CMap * map)
-	: map(map), terrainSel(map), objectSel(map)
+	: map(map), terrainSel(map), objectSel(map), terrainBatch(false)
 {
 
 }
@@ -245,10 +246,26 @@ void CMapEditManager::clearTerrain(CRandomGenerator * gen)
 
 void CMapEditManager::drawTerrain(ETerrainType terType, CRandomGenerator * gen)
 {
-	execute(make_unique<CDrawTerrainOperation>(map, terrainSel, terType, gen ? gen : &(this->gen)));
+	if(terrainBatch)
+		batchedTerrain.push_back(std::make_pair(terrainSel, terType));
+	else
+		execute(make_unique<CDrawTerrainOperation>(map, terrainSel, terType, gen ? gen : &(this->gen)));
 	terrainSel.clearSelection();
 }
 
+void CMapEditManager::startTerrainBatch()
+{
+	terrainBatch = true;
+}
+
+void CMapEditManager::finishTerrainBatch(CRandomGenerator * gen)
+{
+	terrainBatch = false;
+	if(!batchedTerrain.empty())
+		execute(make_unique<CDrawTerrainOperation>(map, batchedTerrain, gen ? gen : &(this->gen)));
+	batchedTerrain.clear();
+}
+
 void CMapEditManager::drawRoad(ERoadType::ERoadType roadType, CRandomGenerator* gen)
 {
 	execute(make_unique<CDrawRoadsOperation>(map, terrainSel, roadType, gen ? gen : &(this->gen)));
@@ -351,8 +368,102 @@ void TerrainViewPattern::WeightedRule::setNative()
 	dirtRule = sandRule = transitionRule = nativeStrongRule = anyRule = false; //no idea what they mean, but look mutually exclusive
 }
 
+/// Results of terrain view validations, shared by all draw terrain operations.
+/// Filled on demand - same neighbourhoods repeat a lot, while all possible ones are far too many to precompute.
+/// Once filled it is mostly read, so threads detecting patterns in parallel look up results under a shared lock.
+class TerrainViewLookupTable : public boost::noncopyable
+{
+public:
+	struct Key
+	{
+		const void * patterns;
+		ui64 inner; //terrain type and classification of 8 adjacent tiles
+		ui64 outer; //classification of 16 tiles in distance of 2
+
+		bool operator==(const Key & other) const
+		{
+			return patterns == other.patterns && inner == other.inner && outer == other.outer;
+		}
+	};
+
+	struct Entry
+	{
+		bool result;
+		ui8 transition; //0 - none, 1 - dirt, 2 - sand
+		ui8 flip;
+	};
+
+	static TerrainViewLookupTable & get()
+	{
+		static TerrainViewLookupTable instance;
+		return instance;
+	}
+
+	bool find(const Key & key, Entry & entry) const
+	{
+		boost::shared_lock<boost::shared_mutex> lock(mx);
+		if(!enabled)
+			return false;
+		auto iter = entries.find(key);
+		if(iter == entries.end())
+			return false;
+		entry = iter->second;
+		return true;
+	}
+
+	void insert(const Key & key, const Entry & entry)
+	{
+		boost::unique_lock<boost::shared_mutex> lock(mx);
+		if(!enabled)
+			return;
+		if(entries.size() >= MAX_ENTRIES)
+			entries.clear();
+		entries[key] = entry;
+	}
+
+	void clear()
+	{
+		boost::unique_lock<boost::shared_mutex> lock(mx);
+		entries.clear();
+	}
+
+	void setEnabled(bool value)
+	{
+		boost::unique_lock<boost::shared_mutex> lock(mx);
+		enabled = value;
+		entries.clear();
+	}
+
+private:
+	static const size_t MAX_ENTRIES = 1 << 20;
+
+	struct KeyHash
+	{
+		size_t operator()(const Key & key) const
+		{
+			size_t ret = 0;
+			boost::hash_combine(ret, key.patterns);
+			boost::hash_combine(ret, key.inner);
+			boost::hash_combine(ret, key.outer);
+			return ret;
+		}
+	};
+
+	TerrainViewLookupTable()
+		: enabled(true)
+	{
+	}
+
+	mutable boost::shared_mutex mx;
+	bool enabled;
+	std::unordered_map<Key, Entry, KeyHash> entries;
+};
+
 CTerrainViewPatternConfig::CTerrainViewPatternConfig()
 {
+	// lookup table is keyed by addresses of patterns, which may be reused by this config
+	TerrainViewLookupTable::get().clear();
+
 	const JsonNode config(ResourceID("config/terrainViewPatterns.json"));
 	static const std::string patternTypes[] = { "terrainView", "terrainType" };
 	for(int i = 0; i < ARRAY_COUNT(patternTypes); ++i)
@@ -533,20 +644,38 @@ void CTerrainViewPatternConfig::flipPattern(TerrainViewPattern & pattern, int fl
 	}
 }
 
+void CTerrainViewPatternConfig::setValidationCacheEnabled(bool enabled)
+{
+	TerrainViewLookupTable::get().setEnabled(enabled);
+}
+
 
 CDrawTerrainOperation::CDrawTerrainOperation(CMap * map, const CTerrainSelection & terrainSel, ETerrainType terType, CRandomGenerator * gen)
-	: CMapOperation(map), terrainSel(terrainSel), terType(terType), gen(gen)
+	: CMapOperation(map), terrainSel(terrainSel), gen(gen)
 {
+	areas.push_back(std::make_pair(terrainSel, terType));
+}
 
+CDrawTerrainOperation::CDrawTerrainOperation(CMap * map, const TAreas & areas, CRandomGenerator * gen)
+	: CMapOperation(map), terrainSel(map), areas(areas), gen(gen)
+{
+	for(const auto & area : areas)
+	{
+		for(const auto & pos : area.first.getSelectedItems())
+			terrainSel.select(pos);
+	}
 }
 
 void CDrawTerrainOperation::execute()
 {
-	for(const auto & pos : terrainSel.getSelectedItems())
+	for(const auto & area : areas)
 	{
-		auto & tile = map->getTile(pos);
-		tile.terType = terType;
-		invalidateTerrainViews(pos);
+		for(const auto & pos : area.first.getSelectedItems())
+		{
+			auto & tile = map->getTile(pos);
+			tile.terType = area.second;
+			invalidateTerrainViews(pos);
+		}
 	}
 
 	updateTerrainTypes();
@@ -703,24 +832,43 @@ void CDrawTerrainOperation::updateTerrainTypes()
 
 void CDrawTerrainOperation::updateTerrainViews()
 {
-	for(const auto & pos : invalidatedTerViews)
+	// Pattern detection only reads terrain types, so it can be split by map region between threads.
+	// Views are assigned afterwards in tile order to keep the random generator sequence unchanged.
+	static const size_t TILES_PER_REGION = 2048;
+
+	std::vector<int3> positions(invalidatedTerViews.begin(), invalidatedTerViews.end());
+	std::vector<int> bestPatterns(positions.size(), -1);
+	std::vector<ValidationResult> valRslts(positions.size(), ValidationResult(false));
+
+	auto detectPatterns = [&](size_t first, size_t last)
 	{
-		const auto & patterns = VLC->terviewh->getTerrainViewPatternsForGroup(getTerrainGroup(map->getTile(pos).terType));
+		for(size_t i = first; i < last; ++i)
+			bestPatterns[i] = findBestPattern(positions[i], valRslts[i]);
+	};
 
-		// Detect a pattern which fits best
-		int bestPattern = -1;
-		ValidationResult valRslt(false);
-		for(int k = 0; k < patterns.size(); ++k)
+	if(positions.size() > TILES_PER_REGION)
+	{
+		std::vector<Task> tasks;
+		for(size_t first = 0; first < positions.size(); first += TILES_PER_REGION)
 		{
-			const auto & pattern = patterns[k];
-			//(ETerrainGroup::ETerrainGroup terGroup, const std::string & id)
-			valRslt = validateTerrainView(pos, &pattern);
-			if(valRslt.result)
-			{
-				bestPattern = k;
-				break;
-			}
+			size_t last = std::min(first + TILES_PER_REGION, positions.size());
+			tasks.push_back(std::bind(detectPatterns, first, last));
 		}
+		CThreadHelper helper(&tasks, std::max<ui32>(1, boost::thread::hardware_concurrency()));
+		helper.run();
+	}
+	else
+	{
+		detectPatterns(0, positions.size());
+	}
+
+	for(size_t i = 0; i < positions.size(); ++i)
+	{
+		const auto & pos = positions[i];
+		const auto & patterns = VLC->terviewh->getTerrainViewPatternsForGroup(getTerrainGroup(map->getTile(pos).terType));
+		int bestPattern = bestPatterns[i];
+		const ValidationResult & valRslt = valRslts[i];
+
 		//assert(bestPattern != -1);
 		if(bestPattern == -1)
 		{
@@ -760,6 +908,20 @@ void CDrawTerrainOperation::updateTerrainViews()
 	}
 }
 
+int CDrawTerrainOperation::findBestPattern(const int3 & pos, ValidationResult & valRslt) const
+{
+	const auto & patterns = VLC->terviewh->getTerrainViewPatternsForGroup(getTerrainGroup(map->getTile(pos).terType));
+
+	// Detect a pattern which fits best
+	for(int k = 0; k < patterns.size(); ++k)
+	{
+		valRslt = validateTerrainView(pos, &patterns[k]);
+		if(valRslt.result)
+			return k;
+	}
+	return -1;
+}
+
 ETerrainGroup::ETerrainGroup CDrawTerrainOperation::getTerrainGroup(ETerrainType terType) const
 {
 	switch(terType)
@@ -778,6 +940,101 @@ ETerrainGroup::ETerrainGroup CDrawTerrainOperation::getTerrainGroup(ETerrainType
 }
 
 CDrawTerrainOperation::ValidationResult CDrawTerrainOperation::validateTerrainView(const int3 & pos, const std::vector<TerrainViewPattern> * pattern, int recDepth) const
+{
+	// nested validations are covered by signature of the top-level one
+	if(recDepth != 0)
+		return validateTerrainViewFlips(pos, pattern, recDepth);
+
+	auto signature = getNeighbourhoodSignature(pos);
+
+	TerrainViewLookupTable::Key key;
+	key.patterns = pattern;
+	key.inner = signature.first;
+	key.outer = signature.second;
+
+	TerrainViewLookupTable::Entry entry;
+	if(!TerrainViewLookupTable::get().find(key, entry))
+	{
+		auto valRslt = validateTerrainViewFlips(pos, pattern, recDepth);
+		entry.result = valRslt.result;
+		entry.flip = valRslt.flip;
+		if(valRslt.transitionReplacement.empty())
+			entry.transition = 0;
+		else
+			entry.transition = valRslt.transitionReplacement == TerrainViewPattern::RULE_DIRT ? 1 : 2;
+		TerrainViewLookupTable::get().insert(key, entry);
+		return valRslt;
+	}
+
+	if(!entry.result)
+		return ValidationResult(false);
+
+	ValidationResult valRslt(true);
+	if(entry.transition != 0)
+		valRslt.transitionReplacement = entry.transition == 1 ? TerrainViewPattern::RULE_DIRT : TerrainViewPattern::RULE_SAND;
+	valRslt.flip = entry.flip;
+	return valRslt;
+}
+
+std::pair<ui64, ui64> CDrawTerrainOperation::getNeighbourhoodSignature(const int3 & pos) const
+{
+	auto centerTerType = map->getTile(pos).terType;
+
+	// same substitution of tiles outside of the map as in validateTerrainViewInner
+	auto classify = [&](const int3 & currentPos) -> ui64
+	{
+		ETerrainType terType;
+		if(!map->isInTheMap(currentPos))
+		{
+			// too far to be ever examined, recursive validation is done only for tiles inside the map
+			if(currentPos.x < -1 || currentPos.y < -1 || currentPos.x > map->width || currentPos.y > map->height)
+				return 7;
+
+			bool widthTooHigh = currentPos.x >= map->width;
+			bool widthTooLess = currentPos.x < 0;
+			bool heightTooHigh = currentPos.y >= map->height;
+			bool heightTooLess = currentPos.y < 0;
+
+			if((widthTooHigh || widthTooLess) && (heightTooHigh || heightTooLess))
+				terType = centerTerType;
+			else if(widthTooHigh)
+				terType = map->getTile(int3(currentPos.x - 1, currentPos.y, currentPos.z)).terType;
+			else if(heightTooHigh)
+				terType = map->getTile(int3(currentPos.x, currentPos.y - 1, currentPos.z)).terType;
+			else if(widthTooLess)
+				terType = map->getTile(int3(currentPos.x + 1, currentPos.y, currentPos.z)).terType;
+			else
+				terType = map->getTile(int3(currentPos.x, currentPos.y + 1, currentPos.z)).terType;
+
+			return isSandType(terType) ? 4 : 3;
+		}
+
+		terType = map->getTile(currentPos).terType;
+		if(terType == centerTerType)
+			return 0;
+		return isSandType(terType) ? 2 : 1;
+	};
+
+	ui64 inner = static_cast<ui64>(centerTerType) + 1;
+	ui64 outer = 0;
+	for(int dy = -2; dy <= 2; ++dy)
+	{
+		for(int dx = -2; dx <= 2; ++dx)
+		{
+			if(dx == 0 && dy == 0)
+				continue;
+
+			ui64 code = classify(int3(pos.x + dx, pos.y + dy, pos.z));
+			if(std::abs(dx) <= 1 && std::abs(dy) <= 1)
+				inner = (inner << 3) | code;
+			else
+				outer = (outer << 3) | code;
+		}
+	}
+	return std::make_pair(inner, outer);
+}
+
+CDrawTerrainOperation::ValidationResult CDrawTerrainOperation::validateTerrainViewFlips(const int3 & pos, const std::vector<TerrainViewPattern> * pattern, int recDepth) const
 {
 	for(int flip = 0; flip < 4; ++flip)
 	{
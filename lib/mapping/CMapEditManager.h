@@ -68,7 +68,7 @@ public:
 	{
 		selectedItems.erase(item);
 	}
-	std::set<T> getSelectedItems()
+	const std::set<T> & getSelectedItems() const
 	{
 		return selectedItems;
 	}
@@ -168,8 +168,17 @@ public:
 	void clearTerrain(CRandomGenerator * gen = nullptr);
 
 	/// Draws terrain at the current terrain selection. The selection will be cleared automatically.
+	/// In batch mode the terrain is only recorded and drawn by finishTerrainBatch.
 	void drawTerrain(ETerrainType terType, CRandomGenerator * gen = nullptr);
 
+	/// Starts batch mode. All following drawTerrain calls are collected and their terrain types and views
+	/// are corrected in one pass when the batch is finished. Later areas overwrite earlier ones.
+	/// Random terrain views are drawn once per tile instead of once per drawTerrain call,
+	/// so the result differs from separate calls with the same random seed.
+	void startTerrainBatch();
+	/// Draws all terrain collected since startTerrainBatch and leaves batch mode.
+	void finishTerrainBatch(CRandomGenerator * gen = nullptr);
+
 	/// Draws roads at the current terrain selection. The selection will be cleared automatically.
 	void drawRoad(ERoadType::ERoadType roadType, CRandomGenerator * gen = nullptr);
 
@@ -188,6 +197,8 @@ private:
 	CRandomGenerator gen;
 	CTerrainSelection terrainSel;
 	CObjectSelection objectSel;
+	bool terrainBatch;
+	std::vector<std::pair<CTerrainSelection, ETerrainType>> batchedTerrain;
 };
 
 /* ---------------------------------------------------------------------------- */
@@ -344,6 +355,9 @@ public:
 	ETerrainGroup::ETerrainGroup getTerrainGroup(const std::string & terGroup) const;
 	void flipPattern(TerrainViewPattern & pattern, int flip) const;
 
+	/// Turns caching of terrain view validation results on or off, cached results are discarded. Intended for tests.
+	static void setValidationCacheEnabled(bool enabled);
+
 private:
 	std::map<ETerrainGroup::ETerrainGroup, std::vector<TVPVector> > terrainViewPatterns;
 	std::map<std::string, TVPVector> terrainTypePatterns;
@@ -353,7 +367,11 @@ private:
 class CDrawTerrainOperation : public CMapOperation
 {
 public:
+	typedef std::vector<std::pair<CTerrainSelection, ETerrainType>> TAreas;
+
 	CDrawTerrainOperation(CMap * map, const CTerrainSelection & terrainSel, ETerrainType terType, CRandomGenerator * gen);
+	/// Draws several areas with different terrain types, terrain types and views are corrected only once.
+	CDrawTerrainOperation(CMap * map, const TAreas & areas, CRandomGenerator * gen);
 
 	void execute() override;
 	void undo() override;
@@ -384,16 +402,24 @@ private:
 	InvalidTiles getInvalidTiles(const int3 & centerPos) const;
 
 	void updateTerrainViews();
+	/// Finds the best fitting pattern for the given tile, returns -1 if there is none.
+	int findBestPattern(const int3 & pos, ValidationResult & valRslt) const;
 	ETerrainGroup::ETerrainGroup getTerrainGroup(ETerrainType terType) const;
 	/// Validates the terrain view of the given position and with the given pattern. The first method wraps the
 	/// second method to validate the terrain view with the given pattern in all four flip directions(horizontal, vertical).
+	/// Results of top-level validations are looked up by neighbourhood signature of the tile if it was seen before.
 	ValidationResult validateTerrainView(const int3 & pos, const std::vector<TerrainViewPattern> * pattern, int recDepth = 0) const;
+	ValidationResult validateTerrainViewFlips(const int3 & pos, const std::vector<TerrainViewPattern> * pattern, int recDepth) const;
 	ValidationResult validateTerrainViewInner(const int3 & pos, const TerrainViewPattern & pattern, int recDepth = 0) const;
+	/// Classifies tiles of 5x5 area around the given position the same way as validation does (native, alien,
+	/// sand, outside of map). Validation result depends only on this signature, terrain type and the pattern.
+	std::pair<ui64, ui64> getNeighbourhoodSignature(const int3 & pos) const;
 	/// Tests whether the given terrain type is a sand type. Sand types are: Water, Sand and Rock
 	bool isSandType(ETerrainType terType) const;
 
+	/// Union of all areas
 	CTerrainSelection terrainSel;
-	ETerrainType terType;
+	TAreas areas;
 	CRandomGenerator * gen;
 	std::set<int3> invalidatedTerViews;
 };
@@ -0,0 +1,156 @@
+/*
+ * CMapHeaderIndex.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "CMapHeaderIndex.h"
+
+#include "CMapService.h"
+#include "../CModHandler.h"
+#include "../CThreadHelper.h"
+#include "../VCMIDirs.h"
+#include "../VCMI_Lib.h"
+#include "../filesystem/Filesystem.h"
+#include "../serializer/BinaryDeserializer.h"
+#include "../serializer/BinarySerializer.h"
+
+static const std::string INDEX_MAGIC = "VCMIMH2";
+
+CMapHeaderIndex::Entry::Entry()
+	: size(0), modificationTime(0), invalid(false)
+{
+}
+
+CMapHeaderIndex::CMapHeaderIndex(boost::filesystem::path indexFile)
+	: indexFile(indexFile)
+{
+	environment = currentEnvironment();
+}
+
+boost::filesystem::path CMapHeaderIndex::defaultIndexFile()
+{
+	return VCMIDirs::get().userCachePath() / "mapHeaders.vindex";
+}
+
+std::string CMapHeaderIndex::currentEnvironment()
+{
+	std::string ret;
+	for(auto & modName : VLC->modh->getActiveMods())
+		ret += boost::str(boost::format("%s:%08x;") % modName % VLC->modh->getModData(modName).checksum);
+	return ret;
+}
+
+void CMapHeaderIndex::load()
+{
+	entries.clear();
+
+	if(!boost::filesystem::exists(indexFile))
+		return;
+
+	try
+	{
+		CLoadFile file(indexFile, SERIALIZATION_VERSION);
+		file.checkMagicBytes(INDEX_MAGIC);
+
+		std::string savedEnvironment;
+		file >> savedEnvironment;
+		if(savedEnvironment != environment)
+		{
+			logGlobal->info("Mods were changed, map header index will be rebuilt");
+			return;
+		}
+		file >> entries;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to read map header index %s: %s", indexFile.string(), e.what());
+		entries.clear();
+	}
+}
+
+void CMapHeaderIndex::save() const
+{
+	try
+	{
+		CSaveFile file(indexFile);
+		file.putMagicBytes(INDEX_MAGIC);
+		file << environment << entries;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to write map header index %s: %s", indexFile.string(), e.what());
+	}
+}
+
+void CMapHeaderIndex::update(const std::unordered_set<ResourceID> & files)
+{
+	std::map<std::string, Entry> updated;
+	std::vector<std::pair<ResourceID, Entry *>> toParse;
+
+	for(auto & file : files)
+	{
+		Entry current;
+		auto realPath = CResourceHandler::get()->getResourceName(file);
+		if(realPath)
+		{
+			boost::system::error_code ec;
+			current.path = realPath->string();
+			current.size = boost::filesystem::file_size(*realPath, ec);
+			current.modificationTime = boost::filesystem::last_write_time(*realPath, ec);
+		}
+
+		auto existing = entries.find(file.getName());
+		if(existing != entries.end()
+			&& existing->second.path == current.path
+			&& existing->second.size == current.size
+			&& existing->second.modificationTime == current.modificationTime)
+		{
+			current.header = std::move(existing->second.header);
+			current.invalid = existing->second.invalid;
+		}
+
+		Entry & entry = updated[file.getName()] = std::move(current);
+		if(!realPath || (!entry.header && !entry.invalid))
+			toParse.push_back(std::make_pair(file, &entry));
+	}
+
+	if(!toParse.empty())
+	{
+		logGlobal->debug("Map header index: parsing %d of %d maps", toParse.size(), files.size());
+
+		std::vector<Task> tasks;
+		for(auto & item : toParse)
+		{
+			tasks.push_back([&item]()
+			{
+				try
+				{
+					item.second->header = CMapService::loadMapHeader(item.first);
+				}
+				catch(const std::exception & e)
+				{
+					logGlobal->error("Map %s is invalid. Message: %s", item.first.getName(), e.what());
+					item.second->invalid = true;
+				}
+			});
+		}
+
+		CThreadHelper helper(&tasks, std::max<ui32>(1, boost::thread::hardware_concurrency()));
+		helper.run();
+	}
+
+	entries = std::move(updated);
+}
+
+const CMapHeader * CMapHeaderIndex::getHeader(const std::string & fileURI) const
+{
+	auto entry = entries.find(fileURI);
+	if(entry == entries.end())
+		return nullptr;
+	return entry->second.header.get();
+}
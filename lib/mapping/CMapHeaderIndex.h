@@ -0,0 +1,69 @@
+/*
+ * CMapHeaderIndex.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "CMap.h"
+
+class ResourceID;
+
+/**
+ * Persistent index of map headers, stored in the user cache directory.
+ *
+ * Header of every map is parsed only once and then reused as long as the
+ * map file keeps its location, size and modification time. Index is dropped
+ * completely if the set of active mods changes, since mods can patch headers.
+ */
+class DLL_LINKAGE CMapHeaderIndex
+{
+public:
+	struct Entry
+	{
+		std::string path; /// path of file in real filesystem
+		ui64 size;
+		si64 modificationTime;
+		std::unique_ptr<CMapHeader> header; /// nullptr if map could not be loaded
+		bool invalid; /// map failed to load, not parsed again until it changes
+
+		Entry();
+
+		template <typename Handler> void serialize(Handler & h, const int version)
+		{
+			h & path;
+			h & size;
+			h & modificationTime;
+			h & header;
+			h & invalid;
+		}
+	};
+
+	/// Creates empty index, call load() to read it from disk
+	CMapHeaderIndex(boost::filesystem::path indexFile = defaultIndexFile());
+
+	/// Reads index from disk. Missing, outdated or broken index is silently treated as empty
+	void load();
+	/// Writes index to disk
+	void save() const;
+
+	/// Makes sure index contains all given maps and only them.
+	/// Maps which are not yet indexed or were modified are parsed in parallel
+	void update(const std::unordered_set<ResourceID> & files);
+
+	/// Returns header of map or nullptr if map is not indexed or is invalid
+	const CMapHeader * getHeader(const std::string & fileURI) const;
+
+	static boost::filesystem::path defaultIndexFile();
+
+private:
+	boost::filesystem::path indexFile;
+	std::string environment; /// active mods and their checksums
+	std::map<std::string, Entry> entries; /// indexed by resource name of map
+
+	static std::string currentEnvironment();
+};
@@ -72,6 +72,13 @@ void CMapInfo::mapInit(const std::string & fname)
 	countPlayers();
 }
 
+void CMapInfo::mapInit(const std::string & fname, const CMapHeader & header)
+{
+	fileURI = fname;
+	mapHeader = make_unique<CMapHeader>(header);
+	countPlayers();
+}
+
 void CMapInfo::campaignInit()
 {
 	campaignHeader = std::unique_ptr<CCampaignHeader>(new CCampaignHeader(CCampaignHandler::getHeader(fileURI)));
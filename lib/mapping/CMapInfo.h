@@ -46,6 +46,7 @@ public:
 	CMapInfo &operator=(CMapInfo &&other);
 
 	void mapInit(const std::string & fname);
+	void mapInit(const std::string & fname, const CMapHeader & header); //uses already loaded header
 	void campaignInit();
 	void countPlayers();
 
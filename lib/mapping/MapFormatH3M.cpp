@@ -15,7 +15,10 @@
 #include "CMap.h"
 
 #include "../CStopWatch.h"
+#include "../ScopeGuard.h"
 #include "../filesystem/Filesystem.h"
+#include "../filesystem/CCompressedStream.h"
+#include "../filesystem/CMemoryStream.h"
 #include "../spells/CSpellHandler.h"
 #include "../CCreatureHandler.h"
 #include "../CGeneralTextHandler.h"
@@ -26,8 +29,6 @@
 #include "../NetPacksBase.h"
 
 
-const bool CMapLoaderH3M::IS_PROFILING_ENABLED = false;
-
 CMapLoaderH3M::CMapLoaderH3M(CInputStream * stream) : map(nullptr), reader(stream),inputStream(stream)
 {
 }
@@ -57,21 +58,6 @@ std::unique_ptr<CMapHeader> CMapLoaderH3M::loadMapHeader()
 
 void CMapLoaderH3M::init()
 {
-	//FIXME: get rid of double input process
-	si64 temp_size = inputStream->getSize();
-	inputStream->seek(0);
-
-	auto  temp_buffer = new ui8[temp_size];
-	inputStream->read(temp_buffer,temp_size);
-
-	// Compute checksum
-	boost::crc_32_type  result;
-	result.process_bytes(temp_buffer, temp_size);
-	map->checksum = result.checksum();
-
-	delete [] temp_buffer;
-	inputStream->seek(0);
-
 	CStopWatch sw;
 
 	struct MapLoadingTime
@@ -87,6 +73,37 @@ void CMapLoaderH3M::init()
 	};
 	std::vector<MapLoadingTime> times;
 
+	// Decompress whole map only once, same data is used to compute checksum and for parsing
+	// Decompressed data is taken over from compressed stream, so only one copy of it exists
+	std::vector<ui8> data;
+	if(auto bufferedStream = dynamic_cast<CBufferedStream *>(inputStream))
+	{
+		data = bufferedStream->releaseData();
+	}
+	else
+	{
+		data.resize(inputStream->getSize());
+		inputStream->seek(0);
+		inputStream->read(data.data(), data.size());
+	}
+	si64 dataSize = data.size();
+	times.push_back(MapLoadingTime("whole file", sw.getDiff()));
+
+	boost::crc_32_type result;
+	result.process_bytes(data.data(), data.size());
+	map->checksum = result.checksum();
+	times.push_back(MapLoadingTime("checksum", sw.getDiff()));
+
+	CMemoryStream dataStream(data.data(), dataSize);
+	CInputStream * originalStream = inputStream;
+	inputStream = &dataStream;
+	reader.setStream(&dataStream);
+	auto onExit = vstd::makeScopeGuard([&]()
+	{
+		inputStream = originalStream;
+		reader.setStream(originalStream);
+	});
+
 	readHeader();
 	times.push_back(MapLoadingTime("header", sw.getDiff()));
 
@@ -122,11 +139,11 @@ void CMapLoaderH3M::init()
 	times.push_back(MapLoadingTime("blocked/visitable tiles", sw.getDiff()));
 
 	// Print profiling times
-	if(IS_PROFILING_ENABLED)
+	if(logGlobal->isTraceEnabled())
 	{
 		for(MapLoadingTime & mlt : times)
 		{
-			logGlobal->debug("\tReading %s took %d ms", mlt.name, mlt.time);
+			logGlobal->trace("\tReading %s took %d ms", mlt.name, mlt.time);
 		}
 	}
 	map->calculateGuardingGreaturePositions();
@@ -15,6 +15,46 @@
 
 extern template void registerTypes<BinaryDeserializer>(BinaryDeserializer & s);
 
+namespace
+{
+	template<typename T>
+	void reverseBytes(ui8 * data, size_t count)
+	{
+		// simple per-element loops like this one are turned into vector shuffles by compilers
+		for(size_t i = 0; i < count; i++)
+		{
+			T value;
+			std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+			T reversed = 0;
+			for(size_t byte = 0; byte < sizeof(T); byte++)
+				reversed |= ((value >> (byte * 8)) & 0xff) << ((sizeof(T) - 1 - byte) * 8);
+			std::memcpy(data + i * sizeof(T), &reversed, sizeof(T));
+		}
+	}
+}
+
+void BinaryDeserializer::reverseRangeEndianess(ui8 * data, size_t elementSize, size_t count)
+{
+	switch(elementSize)
+	{
+	case 1:
+		break;
+	case 2:
+		reverseBytes<ui16>(data, count);
+		break;
+	case 4:
+		reverseBytes<ui32>(data, count);
+		break;
+	case 8:
+		reverseBytes<ui64>(data, count);
+		break;
+	default:
+		for(size_t i = 0; i < count; i++)
+			std::reverse(data + i * elementSize, data + (i + 1) * elementSize);
+		break;
+	}
+}
+
 CLoadFile::CLoadFile(const boost::filesystem::path & fname, int minimalVersion)
 	: serializer(this)
 {
@@ -28,6 +28,12 @@ public:
 	{
 		return reader->read(data, size);
 	};
+
+	/// size of map which loaded tiles must fit into, zero if not known
+	inline int3 getMapSize() const
+	{
+		return reader->mapSize;
+	};
 };
 
 /// Main class for deserialization of classes from binary form
@@ -157,13 +163,21 @@ class DLL_LINKAGE BinaryDeserializer : public CLoaderBase
 
 	int write(const void * data, unsigned size);
 
+	/// Reverses byte order of each of count elements of given size, stored one after another
+	static void reverseRangeEndianess(ui8 * data, size_t elementSize, size_t count);
+
 public:
 	bool reverseEndianess; //if source has different endianness than us, we reverse bytes
 	si32 fileVersion;
 
-	std::map<ui32, void*> loadedPointers;
-	std::map<ui32, const std::type_info*> loadedPointersTypes;
-	std::map<const void*, boost::any> loadedSharedPointers;
+	struct LoadedPointer
+	{
+		void * ptr;
+		const std::type_info * type;
+	};
+
+	std::vector<LoadedPointer> loadedPointers; //indexed by pointer id, saver assigns them sequentially
+	std::unordered_map<const void*, boost::any> loadedSharedPointers;
 	bool smartPointerSerialization;
 	bool saving;
 
@@ -205,10 +219,27 @@ public:
 	void load(T &data)
 	{
 		ui32 size = ARRAY_COUNT(data);
-		for(ui32 i = 0; i < size; i++)
+		loadRange(&data[0], size);
+	}
+
+	/// Loads sequence of elements that are stored one after another in memory
+	template < typename T, typename std::enable_if < !is_blockwise_serializeable<T>::value, int  >::type = 0 >
+	void loadRange(T * data, ui32 count)
+	{
+		for(ui32 i = 0; i < count; i++)
 			load(data[i]);
 	}
 
+	template < typename T, typename std::enable_if < is_blockwise_serializeable<T>::value, int  >::type = 0 >
+	void loadRange(T * data, ui32 count)
+	{
+		if(!count)
+			return;
+		this->read(data, sizeof(T) * count);
+		if(reverseEndianess)
+			reverseRangeEndianess(reinterpret_cast<ui8 *>(data), sizeof(T), count);
+	}
+
 	template < typename T, typename std::enable_if < std::is_enum<T>::value, int  >::type = 0 >
 	void load(T &data)
 	{
@@ -239,8 +270,7 @@ public:
 	{
 		READ_CHECK_U32(length);
 		data.resize(length);
-		for(ui32 i=0;i<length;i++)
-			load( data[i]);
+		loadRange(data.data(), length);
 	}
 
 	template < typename T, typename std::enable_if < std::is_pointer<T>::value, int  >::type = 0 >
@@ -282,14 +312,17 @@ public:
 		if(smartPointerSerialization)
 		{
 			load( pid ); //get the id
-			std::map<ui32, void*>::iterator i = loadedPointers.find(pid); //lookup
 
-			if(i != loadedPointers.end())
+			//saver assigns ids sequentially, so a new pointer always gets the next free one
+			if(pid > loadedPointers.size())
+				throw std::runtime_error("Corrupted stream: pointer id " + std::to_string(pid) + " is out of sequence");
+
+			if(pid < loadedPointers.size() && loadedPointers[pid].ptr)
 			{
 				// We already got this pointer
 				// Cast it in case we are loading it to a non-first base pointer
-				assert(loadedPointersTypes.count(pid));
-				data = reinterpret_cast<T>(typeList.castRaw(i->second, loadedPointersTypes.at(pid), &typeid(typename std::remove_const<typename std::remove_pointer<T>::type>::type)));
+				const LoadedPointer & loaded = loadedPointers[pid];
+				data = reinterpret_cast<T>(typeList.castRaw(loaded.ptr, loaded.type, &typeid(typename std::remove_const<typename std::remove_pointer<T>::type>::type)));
 				return;
 			}
 		}
@@ -325,8 +358,10 @@ public:
 	{
 		if(smartPointerSerialization && pid != 0xffffffff)
 		{
-			loadedPointersTypes[pid] = &typeid(T);
-			loadedPointers[pid] = (void*)ptr; //add loaded pointer to our lookup map; cast is to avoid errors with const T* pt
+			if(pid >= loadedPointers.size())
+				loadedPointers.resize(pid + 1, LoadedPointer{nullptr, nullptr});
+			//add loaded pointer to our lookup table; cast is to avoid errors with const T* pt
+			loadedPointers[pid] = LoadedPointer{(void*)ptr, &typeid(T)};
 		}
 	}
 
@@ -395,8 +430,7 @@ public:
 	template <typename T, size_t N>
 	void load(std::array<T, N> &data)
 	{
-		for(ui32 i = 0; i < N; i++)
-			load( data[i] );
+		loadRange(data.data(), N);
 	}
 	template <typename T>
 	void load(std::set<T> &data)
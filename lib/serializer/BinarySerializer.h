@@ -25,6 +25,12 @@ public:
 	{
 		return writer->write(data, size);
 	};
+
+	/// size of map which saved tiles fit into, zero if not known
+	inline int3 getMapSize() const
+	{
+		return writer->mapSize;
+	};
 };
 
 /// Main class for serialization of classes into binary form
@@ -109,7 +115,7 @@ class DLL_LINKAGE BinarySerializer : public CSaverBase
 	CApplier<CBasicPointerSaver> applier;
 
 public:
-	std::map<const void*, ui32> savedPointers;
+	std::unordered_map<const void*, ui32> savedPointers;
 
 	bool smartPointerSerialization;
 	bool saving;
@@ -118,6 +124,7 @@ public:
 	{
 		saving=true;
 		smartPointerSerialization = true;
+		savedPointers.reserve(1024);
 	}
 
 	template<typename Base, typename Derived>
@@ -166,8 +173,23 @@ public:
 	void save(const T &data)
 	{
 		ui32 size = ARRAY_COUNT(data);
-		for(ui32 i=0; i < size; i++)
-			*this & data[i];
+		saveRange(&data[0], size);
+	}
+
+	/// Saves sequence of elements that are stored one after another in memory
+	template < typename T, typename std::enable_if < !is_blockwise_serializeable<T>::value, int  >::type = 0 >
+	void saveRange(const T * data, ui32 count)
+	{
+		for(ui32 i = 0; i < count; i++)
+			save(data[i]);
+	}
+
+	template < typename T, typename std::enable_if < is_blockwise_serializeable<T>::value, int  >::type = 0 >
+	void saveRange(const T * data, ui32 count)
+	{
+		// whole block can be dumped at once - its binary form is same as element-by-element one
+		if(count)
+			this->write(data, sizeof(T) * count);
 	}
 
 	template < typename T, typename std::enable_if < std::is_pointer<T>::value, int  >::type = 0 >
@@ -208,7 +230,7 @@ public:
 			// We might have an object that has multiple inheritance and store it via the non-first base pointer.
 			// Therefore, all pointers need to be normalized to the actual object address.
 			auto actualPointer = typeList.castToMostDerived(data);
-			std::map<const void*,ui32>::iterator i = savedPointers.find(actualPointer);
+			auto i = savedPointers.find(actualPointer);
 			if(i != savedPointers.end())
 			{
 				//this pointer has been already serialized - write only it's id
@@ -255,14 +277,12 @@ public:
 	{
 		ui32 length = data.size();
 		*this & length;
-		for(ui32 i=0;i<length;i++)
-			save(data[i]);
+		saveRange(data.data(), length);
 	}
 	template <typename T, size_t N>
 	void save(const std::array<T, N> &data)
 	{
-		for(ui32 i=0; i < N; i++)
-			save(data[i]);
+		saveRange(data.data(), N);
 	}
 	template <typename T>
 	void save(const std::set<T> &data)
@@ -29,6 +29,7 @@ CSerializer::CSerializer()
 
 void CSerializer::addStdVecItems(CGameState *gs, LibClasses *lib)
 {
+	mapSize = int3(gs->map->width, gs->map->height, gs->map->twoLevel ? 2 : 1);
 	registerVectoredType<CGObjectInstance, ObjectInstanceID>(&gs->map->objects,
 		[](const CGObjectInstance &obj){ return obj.id; });
 	registerVectoredType<CHero, HeroTypeID>(&lib->heroh->heroes,
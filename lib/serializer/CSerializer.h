@@ -11,6 +11,7 @@
 
 #include "../ConstTransitivePtr.h"
 #include "../GameConstants.h"
+#include "../int3.h"
 
 const ui32 SERIALIZATION_VERSION = 777;
 const ui32 MINIMAL_SERIALIZATION_VERSION = 753;
@@ -80,6 +81,7 @@ class DLL_LINKAGE CSerializer
 public:
 	bool smartVectorMembersSerialization;
 	bool sendStackInstanceByIds;
+	int3 mapSize; //size of map of registered game state, used to validate received tiles; zero if not known
 
 	CSerializer();
 	~CSerializer();
@@ -143,6 +145,14 @@ struct is_serializeable
 	static const bool value = sizeof(Yes) == sizeof(is_serializeable::test((typename std::remove_reference<typename std::remove_cv<T>::type>::type*)0));
 };
 
+/// Helper to detect types which binary form is identical to their in-memory representation
+/// Sequences of such types are (de)serialized as single memory block instead of element-by-element
+template<class T>
+struct is_blockwise_serializeable
+{
+	static const bool value = std::is_fundamental<T>::value && !std::is_same<T, bool>::value;
+};
+
 template <typename T> //metafunction returning CGObjectInstance if T is its derivate or T elsewise
 struct VectorizedTypeFor
 {
@@ -99,14 +99,87 @@ std::vector<CTypeList::TypeInfoPtr> CTypeList::castSequence(TypeInfoPtr from, Ty
 	return ret;
 }
 
-std::vector<CTypeList::TypeInfoPtr> CTypeList::castSequence(const std::type_info *from, const std::type_info *to) const
+const CTypeList::TCastPath & CTypeList::castPath(const std::type_info *from, const std::type_info *to, TCastPath & buffer) const
 {
 	//This additional if is needed because getTypeDescriptor might fail if type is not registered
 	// (and if casting is not needed, then registereing should no  be required)
 	if(!strcmp(from->name(), to->name()))
-		return std::vector<CTypeList::TypeInfoPtr>();
+		return buffer;
+
+	if(auto cached = castPaths.find(from, to))
+		return *cached;
+
+	TSharedLock lock(mx);
+	auto fromDescr = getTypeDescriptor(from);
+	auto toDescr = getTypeDescriptor(to);
+
+	auto typesSequence = castSequence(fromDescr, toDescr);
+	for(int i = 0; i < static_cast<int>(typesSequence.size()) - 1; i++)
+	{
+		auto castingPair = std::make_pair(typesSequence[i], typesSequence[i + 1]);
+		auto caster = casters.find(castingPair);
+		if(caster == casters.end())
+			THROW_FORMAT("Cannot find caster for conversion %s -> %s which is needed to cast %s -> %s", castingPair.first->name % castingPair.second->name % from->name() % to->name());
+
+		buffer.push_back(caster->second.get());
+	}
+
+	if(auto cached = castPaths.insert(from, to, buffer))
+		return *cached;
+
+	return buffer;
+}
+
+CTypeList::CastPathCache::CastPathCache()
+	: entries(new Entry[CAPACITY])
+{
+}
+
+size_t CTypeList::CastPathCache::hash(const std::type_info * from, const std::type_info * to)
+{
+	size_t ret = std::hash<const void *>()(from);
+	vstd::hash_combine(ret, static_cast<const void *>(to));
+	return ret;
+}
+
+const CTypeList::TCastPath * CTypeList::CastPathCache::find(const std::type_info * from, const std::type_info * to) const
+{
+	const size_t start = hash(from, to);
+	for(ui32 probe = 0; probe < MAX_PROBES; probe++)
+	{
+		const Entry & entry = entries[(start + probe) & (CAPACITY - 1)];
+		const std::type_info * entryFrom = entry.from.load(std::memory_order_acquire);
+		if(entryFrom == nullptr)
+			return nullptr;
+		if(entryFrom == from && entry.to.load(std::memory_order_relaxed) == to)
+			return entry.path.load(std::memory_order_relaxed);
+	}
+	return nullptr;
+}
+
+const CTypeList::TCastPath * CTypeList::CastPathCache::insert(const std::type_info * from, const std::type_info * to, const TCastPath & path)
+{
+	// insertions are rare and serialized, readers never wait for them
+	boost::mutex::scoped_lock lock(storageMx);
 
-	return castSequence(getTypeDescriptor(from), getTypeDescriptor(to));
+	const size_t start = hash(from, to);
+	for(ui32 probe = 0; probe < MAX_PROBES; probe++)
+	{
+		Entry & entry = entries[(start + probe) & (CAPACITY - 1)];
+		const std::type_info * entryFrom = entry.from.load(std::memory_order_relaxed);
+		if(entryFrom == from && entry.to.load(std::memory_order_relaxed) == to)
+			return entry.path.load(std::memory_order_relaxed);
+		if(entryFrom == nullptr)
+		{
+			storage.push_back(make_unique<TCastPath>(path));
+			// path and target must be visible before the source type, readers rely on it
+			entry.path.store(storage.back().get(), std::memory_order_relaxed);
+			entry.to.store(to, std::memory_order_relaxed);
+			entry.from.store(from, std::memory_order_release);
+			return storage.back().get();
+		}
+	}
+	return nullptr;
 }
 
 CTypeList::TypeInfoPtr CTypeList::getTypeDescriptor(const std::type_info *type, bool throws) const
@@ -13,6 +13,7 @@
 
 struct IPointerCaster
 {
+	virtual void * castPtr(void * ptr) const = 0; // takes From*, returns To*
 	virtual boost::any castRawPtr(const boost::any &ptr) const = 0; // takes From*, returns To*
 	virtual boost::any castSharedPtr(const boost::any &ptr) const = 0; // takes std::shared_ptr<From>, performs dynamic cast, returns std::shared_ptr<To>
 	virtual boost::any castWeakPtr(const boost::any &ptr) const = 0; // takes std::weak_ptr<From>, performs dynamic cast, returns std::weak_ptr<To>. The object under poitner must live.
@@ -22,13 +23,18 @@ struct IPointerCaster
 template <typename From, typename To>
 struct PointerCaster : IPointerCaster
 {
-	virtual boost::any castRawPtr(const boost::any &ptr) const override // takes void* pointing to From object, performs dynamic cast, returns void* pointing to To object
+	virtual void * castPtr(void * ptr) const override // takes void* pointing to From object, performs static cast, returns void* pointing to To object
 	{
-		From * from = (From*)boost::any_cast<void*>(ptr);
+		From * from = (From*)ptr;
 		To * ret = static_cast<To*>(from);
 		return (void*)ret;
 	}
 
+	virtual boost::any castRawPtr(const boost::any &ptr) const override
+	{
+		return castPtr(boost::any_cast<void*>(ptr));
+	}
+
 	// Helper function performing casts between smart pointers
 	template<typename SmartPt>
 	boost::any castSmartPtr(const boost::any &ptr) const
@@ -74,8 +80,41 @@ class DLL_LINKAGE CTypeList: public boost::noncopyable
 	typedef boost::shared_mutex TMutex;
 	typedef boost::unique_lock<TMutex> TUniqueLock;
 	typedef boost::shared_lock<TMutex> TSharedLock;
+	typedef std::vector<const IPointerCaster *> TCastPath;
+
+	/// Cache of cast paths between pairs of types, indexed by their std::type_info
+	/// Lookups are lock-free and don't need type descriptors. Entries are never invalidated since registered relations are never removed
+	/// Same type may have several std::type_info objects (one per module), each of them gets own entry
+	class CastPathCache : public boost::noncopyable
+	{
+		struct Entry
+		{
+			std::atomic<const std::type_info *> from; //written last, entry is valid once it is set
+			std::atomic<const std::type_info *> to;
+			std::atomic<const TCastPath *> path;
+
+			Entry(): from(nullptr), to(nullptr), path(nullptr) {}
+		};
+
+		static const ui32 CAPACITY = 8192; //must be power of 2
+		static const ui32 MAX_PROBES = 64;
+
+		std::unique_ptr<Entry[]> entries;
+		boost::mutex storageMx;
+		std::vector<std::unique_ptr<TCastPath>> storage;
+
+		static size_t hash(const std::type_info * from, const std::type_info * to);
+	public:
+		CastPathCache();
+
+		/// Returns cached path or nullptr if none
+		const TCastPath * find(const std::type_info * from, const std::type_info * to) const;
+		/// Stores copy of path in cache and returns it. Returns nullptr if cache is full
+		const TCastPath * insert(const std::type_info * from, const std::type_info * to, const TCastPath & path);
+	};
 private:
 	mutable TMutex mx;
+	mutable CastPathCache castPaths;
 
 	std::map<const std::type_info *, TypeInfoPtr, TypeComparer> typeInfos;
 	std::map<std::pair<TypeInfoPtr, TypeInfoPtr>, std::unique_ptr<const IPointerCaster>> casters; //for each pair <Base, Der> we provide a caster (each registered relations creates a single entry here)
@@ -83,26 +122,18 @@ private:
 	/// Returns sequence of types starting from "from" and ending on "to". Every next type is derived from the previous.
 	/// Throws if there is no link registered.
 	std::vector<TypeInfoPtr> castSequence(TypeInfoPtr from, TypeInfoPtr to) const;
-	std::vector<TypeInfoPtr> castSequence(const std::type_info *from, const std::type_info *to) const;
+
+	/// Returns sequence of casters that converts pointer to "from" into pointer to "to". Result is computed once for each pair of types.
+	/// If path can't be cached, it is stored in provided buffer. Throws if there is no link registered.
+	const TCastPath & castPath(const std::type_info *from, const std::type_info *to, TCastPath & buffer) const;
 
 	template<boost::any(IPointerCaster::*CastingFunction)(const boost::any &) const>
 	boost::any castHelper(boost::any inputPtr, const std::type_info *fromArg, const std::type_info *toArg) const
 	{
-		TSharedLock lock(mx);
-		auto typesSequence = castSequence(fromArg, toArg);
-
+		TCastPath buffer;
 		boost::any ptr = inputPtr;
-		for(int i = 0; i < static_cast<int>(typesSequence.size()) - 1; i++)
-		{
-			auto &from = typesSequence[i];
-			auto &to = typesSequence[i + 1];
-			auto castingPair = std::make_pair(from, to);
-			if(!casters.count(castingPair))
-				THROW_FORMAT("Cannot find caster for conversion %s -> %s which is needed to cast %s -> %s", from->name % to->name % fromArg->name() % toArg->name());
-
-			auto &caster = casters.at(castingPair);
-			ptr = (*caster.*CastingFunction)(ptr); //Why does unique_ptr not have operator->* ..?
-		}
+		for(auto caster : castPath(fromArg, toArg, buffer))
+			ptr = (caster->*CastingFunction)(ptr);
 
 		return ptr;
 	}
@@ -132,6 +163,11 @@ public:
 		auto bti = registerType(bt);
 		auto dti = registerType(dt); //obtain our TypeDescriptor
 
+		// relation may be already known - every serializer registers all types again
+		// casters must stay intact, cached cast paths refer to them
+		if(casters.count(std::make_pair(bti, dti)))
+			return;
+
 		// register the relation between classes
 		bti->children.push_back(dti);
 		dti->parents.push_back(bti);
@@ -158,9 +194,7 @@ public:
 			return const_cast<void*>(reinterpret_cast<const void*>(inputPtr));
 		}
 
-		return boost::any_cast<void*>(castHelper<&IPointerCaster::castRawPtr>(
-			const_cast<void*>(reinterpret_cast<const void*>(inputPtr)), &baseType,
-			derivedType));
+		return castRaw(const_cast<void*>(reinterpret_cast<const void*>(inputPtr)), &baseType, derivedType);
 	}
 
 	template<typename TInput>
@@ -177,7 +211,11 @@ public:
 
 	void * castRaw(void *inputPtr, const std::type_info *from, const std::type_info *to) const
 	{
-		return boost::any_cast<void*>(castHelper<&IPointerCaster::castRawPtr>(inputPtr, from, to));
+		TCastPath buffer;
+		for(auto caster : castPath(from, to, buffer))
+			inputPtr = caster->castPtr(inputPtr);
+
+		return inputPtr;
 	}
 	boost::any castShared(boost::any inputPtr, const std::type_info *from, const std::type_info *to) const
 	{
@@ -29,11 +29,65 @@ using namespace boost::asio::ip;
 #define LIL_ENDIAN
 #endif
 
+/// Frames are kept whole in memory, anything bigger is treated as corrupted stream
+static const ui32 MAX_FRAME_SIZE = 512 * 1024 * 1024;
+/// Frame buffer grows by at most this much ahead of data actually received
+static const size_t FRAME_GROWTH_STEP = 1024 * 1024;
+static const size_t RECEIVE_BUFFER_SIZE = 64 * 1024;
+
+CLocalFrameQueue::CLocalFrameQueue()
+	: closed(false)
+{
+
+}
+
+bool CLocalFrameQueue::push(std::vector<ui8> && frame)
+{
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		if(closed)
+			return false;
+		frames.push_back(std::move(frame));
+	}
+	cond.notify_one();
+	return true;
+}
+
+bool CLocalFrameQueue::pop(std::vector<ui8> & frame)
+{
+	boost::unique_lock<boost::mutex> lock(mx);
+	while(frames.empty() && !closed)
+		cond.wait(lock);
+
+	if(frames.empty())
+		return false;
+
+	frame = std::move(frames.front());
+	frames.pop_front();
+	return true;
+}
+
+void CLocalFrameQueue::close()
+{
+	{
+		boost::unique_lock<boost::mutex> lock(mx);
+		closed = true;
+	}
+	cond.notify_all();
+}
 
 void CConnection::init()
 {
-	boost::asio::ip::tcp::no_delay option(true);
-	socket->set_option(option);
+	if(socket)
+	{
+		boost::asio::ip::tcp::no_delay option(true);
+		socket->set_option(option);
+	}
+
+	smx = new boost::mutex();
+	framePos = 0;
+	receiveBuffer.resize(RECEIVE_BUFFER_SIZE);
+	receivePos = receiveEnd = 0;
 
 	enableSmartPointerSerialization();
 	disableStackSendingByID();
@@ -45,11 +99,16 @@ void CConnection::init()
 	myEndianess = false;
 #endif
 	connected = true;
-	std::string pom;
-	//we got connection
-	oser & std::string("Aiya!\n") & name & myEndianess; //identify ourselves
-	iser & pom & pom & contactEndianess;
-	logNetwork->info("Established connection with %s", pom);
+	if(isLocal())
+	{
+		//other side is in the same process, there is nothing to negotiate
+		contactEndianess = myEndianess;
+		logNetwork->info("Established local connection %s", name);
+	}
+	else
+	{
+		handshake();
+	}
 	wmx = new boost::mutex();
 	rmx = new boost::mutex();
 
@@ -60,6 +119,17 @@ void CConnection::init()
 	iser.fileVersion = SERIALIZATION_VERSION;
 }
 
+void CConnection::handshake()
+{
+	std::string pom;
+	//we got connection
+	oser & std::string("Aiya!\n") & name & myEndianess; //identify ourselves
+	flushFrame(typeid(std::string));
+	iser & pom & pom & contactEndianess;
+	finishReading(typeid(std::string));
+	logNetwork->info("Established connection with %s", pom);
+}
+
 CConnection::CConnection(std::string host, ui16 port, std::string Name)
 :iser(this), oser(this), io_service(new asio::io_service), name(Name)
 {
@@ -134,27 +204,158 @@ CConnection::CConnection(TAcceptor * acceptor, boost::asio::io_service *Io_servi
 	}
 	init();
 }
+CConnection::CConnection(std::shared_ptr<CLocalFrameQueue> input, std::shared_ptr<CLocalFrameQueue> output, std::string Name)
+	: localInput(input), localOutput(output), iser(this), oser(this), socket(nullptr), io_service(nullptr), name(Name)
+{
+	init();
+}
+
+std::pair<std::unique_ptr<CConnection>, std::unique_ptr<CConnection>> CConnection::createLocalPair(std::string firstName, std::string secondName)
+{
+	auto firstToSecond = std::make_shared<CLocalFrameQueue>();
+	auto secondToFirst = std::make_shared<CLocalFrameQueue>();
+	auto first = make_unique<CConnection>(secondToFirst, firstToSecond, firstName);
+	auto second = make_unique<CConnection>(firstToSecond, secondToFirst, secondName);
+	return std::make_pair(std::move(first), std::move(second));
+}
+
 int CConnection::write(const void * data, unsigned size)
 {
+	auto bytes = static_cast<const ui8 *>(data);
+	writeBuffer.insert(writeBuffer.end(), bytes, bytes + size);
+	return size;
+}
+int CConnection::read(void * data, unsigned size)
+{
+	auto bytes = static_cast<ui8 *>(data);
+	unsigned left = size;
+	while(left)
+	{
+		if(framePos == frame.size())
+			receiveFrame();
+
+		size_t chunk = std::min<size_t>(left, frame.size() - framePos);
+		std::copy_n(frame.data() + framePos, chunk, bytes);
+		framePos += chunk;
+		bytes += chunk;
+		left -= chunk;
+	}
+	return size;
+}
+
+void CConnection::flushFrame(std::type_index type)
+{
+	if(writeBuffer.empty())
+		return;
+
+	ui32 size = writeBuffer.size();
+	if(localOutput)
+	{
+		//frame is handed over as whole, without copying
+		bool pushed = localOutput->push(std::move(writeBuffer));
+		writeBuffer.clear();
+		if(!pushed)
+		{
+			connected = false;
+			throw std::runtime_error("Local connection has been closed");
+		}
+
+		boost::unique_lock<boost::mutex> lock(*smx);
+		auto & stats = sentStats[type];
+		stats.count++;
+		stats.frames++;
+		stats.bytes += size;
+		return;
+	}
+
+	const ui8 header[4] = {ui8(size), ui8(size >> 8), ui8(size >> 16), ui8(size >> 24)}; //always little endian
 	try
 	{
-		int ret;
-		ret = asio::write(*socket,asio::const_buffers_1(asio::const_buffer(data,size)));
-		return ret;
+		//header and data are sent by single gathering write
+		std::array<asio::const_buffer, 2> buffers = {{asio::buffer(header), asio::buffer(writeBuffer)}};
+		asio::write(*socket, buffers);
 	}
 	catch(...)
 	{
 		//connection has been lost
 		connected = false;
+		writeBuffer.clear();
 		throw;
 	}
+	writeBuffer.clear();
+
+	boost::unique_lock<boost::mutex> lock(*smx);
+	auto & stats = sentStats[type];
+	stats.count++;
+	stats.frames++;
+	stats.bytes += size + sizeof(header);
+	stats.syscalls++;
 }
-int CConnection::read(void * data, unsigned size)
+
+void CConnection::receiveFrame()
+{
+	if(localInput)
+	{
+		if(!localInput->pop(frame))
+		{
+			connected = false;
+			throw std::runtime_error("Local connection has been closed");
+		}
+		framePos = 0;
+		pendingRead.frames++;
+		pendingRead.bytes += frame.size();
+		return;
+	}
+
+	ui8 header[4];
+	receive(header, sizeof(header));
+	ui32 size = header[0] | (header[1] << 8) | (header[2] << 16) | (ui32(header[3]) << 24);
+	if(size > MAX_FRAME_SIZE)
+	{
+		connected = false;
+		throw std::runtime_error(boost::str(boost::format("Received frame of size %d exceeds the limit") % size));
+	}
+
+	//size in header is not trusted, buffer grows only as data arrives
+	frame.clear();
+	while(frame.size() < size)
+	{
+		size_t received = frame.size();
+		frame.resize(std::min<size_t>(size, received + FRAME_GROWTH_STEP));
+		receive(frame.data() + received, frame.size() - received);
+	}
+	framePos = 0;
+
+	pendingRead.frames++;
+	pendingRead.bytes += size + sizeof(header);
+}
+
+void CConnection::receive(void * data, size_t size)
 {
+	auto bytes = static_cast<ui8 *>(data);
 	try
 	{
-		int ret = asio::read(*socket,asio::mutable_buffers_1(asio::mutable_buffer(data,size)));
-		return ret;
+		while(size)
+		{
+			if(receivePos == receiveEnd)
+			{
+				pendingRead.syscalls++;
+				if(size >= receiveBuffer.size())
+				{
+					//big frames are read directly to their destination
+					asio::read(*socket, asio::buffer(bytes, size));
+					return;
+				}
+				receiveEnd = socket->read_some(asio::buffer(receiveBuffer));
+				receivePos = 0;
+			}
+
+			size_t chunk = std::min(size, receiveEnd - receivePos);
+			std::copy_n(receiveBuffer.data() + receivePos, chunk, bytes);
+			receivePos += chunk;
+			bytes += chunk;
+			size -= chunk;
+		}
 	}
 	catch(...)
 	{
@@ -163,6 +364,18 @@ int CConnection::read(void * data, unsigned size)
 		throw;
 	}
 }
+
+void CConnection::finishReading(std::type_index type)
+{
+	boost::unique_lock<boost::mutex> lock(*smx);
+	auto & stats = receivedStats[type];
+	stats.count++;
+	stats.frames += pendingRead.frames;
+	stats.bytes += pendingRead.bytes;
+	stats.syscalls += pendingRead.syscalls;
+	pendingRead = CConnectionStats();
+}
+
 CConnection::~CConnection(void)
 {
 	if(handler)
@@ -170,10 +383,12 @@ CConnection::~CConnection(void)
 
 	delete handler;
 
+	reportStats(logNetwork);
 	close();
 	delete io_service;
 	delete wmx;
 	delete rmx;
+	delete smx;
 }
 
 template<class T>
@@ -192,11 +407,18 @@ void CConnection::close()
 		socket->close();
 		vstd::clear_pointer(socket);
 	}
+	if(isLocal())
+	{
+		//wakes up reader on both sides
+		localInput->close();
+		localOutput->close();
+		connected = false;
+	}
 }
 
 bool CConnection::isOpen() const
 {
-	return socket && connected;
+	return (socket || isLocal()) && connected;
 }
 
 bool CConnection::isHost() const
@@ -204,6 +426,11 @@ bool CConnection::isHost() const
 	return connectionID == 1;
 }
 
+bool CConnection::isLocal() const
+{
+	return localInput && localOutput;
+}
+
 void CConnection::reportState(vstd::CLoggerBase * out)
 {
 	out->debug("CConnection");
@@ -212,6 +439,22 @@ void CConnection::reportState(vstd::CLoggerBase * out)
 		out->debug("\tWe have an open and valid socket");
 		out->debug("\t %d bytes awaiting", socket->available());
 	}
+	reportStats(out);
+}
+
+void CConnection::reportStats(vstd::CLoggerBase * out) const
+{
+	boost::unique_lock<boost::mutex> lock(*smx);
+	auto print = [out](const std::string & direction, const std::map<std::type_index, CConnectionStats> & allStats)
+	{
+		for(const auto & stats : allStats)
+		{
+			out->debug("\t%s %s: %d times, %d frames, %d bytes, %d syscalls", direction, stats.first.name(),
+				stats.second.count, stats.second.frames, stats.second.bytes, stats.second.syscalls);
+		}
+	};
+	print("Sent", sentStats);
+	print("Received", receivedStats);
 }
 
 CPack * CConnection::retreivePack()
@@ -220,6 +463,7 @@ CPack * CConnection::retreivePack()
 	boost::unique_lock<boost::mutex> lock(*rmx);
 	logNetwork->trace("Listening... ");
 	iser & ret;
+	finishReading(typeOf(ret));
 	logNetwork->trace("\treceived server message of type %s", (ret? typeid(*ret).name() : "nullptr"));
 	return ret;
 }
@@ -229,6 +473,7 @@ void CConnection::sendPackToServer(const CPack &pack, PlayerColor player, ui32 r
 	boost::unique_lock<boost::mutex> lock(*wmx);
 	logNetwork->trace("Sending to server a pack of type %s", typeid(pack).name());
 	oser & player & requestID & &pack; //packs has to be sent as polymorphic pointers!
+	flushFrame(typeid(pack));
 }
 
 void CConnection::disableStackSendingByID()
@@ -12,6 +12,8 @@
 #include "BinaryDeserializer.h"
 #include "BinarySerializer.h"
 
+#include <typeindex>
+
 struct CPack;
 
 namespace boost
@@ -38,23 +40,82 @@ namespace boost
 typedef boost::asio::basic_stream_socket < boost::asio::ip::tcp , boost::asio::stream_socket_service<boost::asio::ip::tcp>  > TSocket;
 typedef boost::asio::basic_socket_acceptor<boost::asio::ip::tcp, boost::asio::socket_acceptor_service<boost::asio::ip::tcp> > TAcceptor;
 
+/// Amount of network traffic caused by one type of data
+struct DLL_LINKAGE CConnectionStats
+{
+	ui64 count, frames, bytes, syscalls;
+
+	CConnectionStats() : count(0), frames(0), bytes(0), syscalls(0) {}
+};
+
+/// Queue of frames passed between two connections living in the same process
+class DLL_LINKAGE CLocalFrameQueue : public boost::noncopyable
+{
+	boost::mutex mx;
+	boost::condition_variable cond;
+	std::deque<std::vector<ui8>> frames;
+	bool closed;
+public:
+	CLocalFrameQueue();
+
+	/// Returns false if the queue was closed, frame is dropped then
+	bool push(std::vector<ui8> && frame);
+	/// Waits for next frame, returns false if the queue was closed
+	bool pop(std::vector<ui8> & frame);
+	void close();
+};
+
 /// Main class for network communication
 /// Allows establishing connection and bidirectional read-write
+/// Everything written between two flushes is sent as one frame prefixed by its length,
+/// frames are received as whole before they are deserialized.
+/// Connections within one process can exchange frames through memory instead of a socket.
 class DLL_LINKAGE CConnection
 	: public IBinaryReader, public IBinaryWriter
 {
 	CConnection(void);
 
 	void init();
+	void handshake();
 	void reportState(vstd::CLoggerBase * out) override;
 
 	int write(const void * data, unsigned size) override;
 	int read(void * data, unsigned size) override;
+
+	/// Sends all data written since last flush as single frame
+	void flushFrame(std::type_index type);
+	void receiveFrame();
+	/// Reads raw data from socket, small reads are served from buffer filled by as few syscalls as possible
+	void receive(void * data, size_t size);
+	void finishReading(std::type_index type);
+
+	template<typename T>
+	static std::type_index typeOf(const T & t)
+	{
+		return typeid(T);
+	}
+
+	template<typename T>
+	static std::type_index typeOf(T * const & t)
+	{
+		return t ? typeid(*t) : typeid(T);
+	}
+
+	std::vector<ui8> writeBuffer;
+	std::vector<ui8> frame;
+	size_t framePos;
+	std::vector<ui8> receiveBuffer;
+	size_t receivePos, receiveEnd;
+
+	std::shared_ptr<CLocalFrameQueue> localInput, localOutput; //used instead of socket by local connections
+
+	CConnectionStats pendingRead; //traffic of data which is being deserialized
+	std::map<std::type_index, CConnectionStats> sentStats, receivedStats;
 public:
 	BinaryDeserializer iser;
 	BinarySerializer oser;
 
-	boost::mutex *rmx, *wmx; // read/write mutexes
+	boost::mutex *rmx, *wmx, *smx; // read/write/statistics mutexes
 	TSocket * socket;
 	bool connected;
 	bool myEndianess, contactEndianess; //true if little endian, if endianness is different we'll have to revert received multi-byte vars
@@ -69,10 +130,15 @@ public:
 	CConnection(std::string host, ui16 port, std::string Name);
 	CConnection(TAcceptor * acceptor, boost::asio::io_service *Io_service, std::string Name);
 	CConnection(TSocket * Socket, std::string Name); //use immediately after accepting connection into socket
+	CConnection(std::shared_ptr<CLocalFrameQueue> input, std::shared_ptr<CLocalFrameQueue> output, std::string Name);
+
+	/// Creates two connected connections which pass frames in memory, without sockets and syscalls
+	static std::pair<std::unique_ptr<CConnection>, std::unique_ptr<CConnection>> createLocalPair(std::string firstName, std::string secondName);
 
 	void close();
 	bool isOpen() const;
 	bool isHost() const;
+	bool isLocal() const;
 	template<class T>
 	CConnection &operator&(const T&);
 	virtual ~CConnection(void);
@@ -91,11 +157,13 @@ public:
 	void enterPregameConnectionMode();
 
 	std::string toString() const;
+	void reportStats(vstd::CLoggerBase * out) const;
 
 	template<class T>
 	CConnection & operator>>(T &t)
 	{
 		iser & t;
+		finishReading(typeOf(t));
 		return * this;
 	}
 
@@ -103,6 +171,7 @@ public:
 	CConnection & operator<<(const T &t)
 	{
 		oser & t;
+		flushFrame(typeOf(t));
 		return * this;
 	}
 };
@@ -462,6 +462,56 @@ void ERMInterpreter::scanScripts()
 	{
 		boost::apply_visitor(ScriptScanner(this, it->first), it->second);
 	}
+
+	compileTriggers(triggers, triggerIndex);
+	compileTriggers(postTriggers, postTriggerIndex);
+}
+
+void ERMInterpreter::compileTriggers(TtriggerListType & triggerList, TtriggerIndexType & index)
+{
+	for(auto & triggersOfType : triggerList)
+	{
+		TriggerIndex & typeIndex = index[triggersOfType.first];
+
+		for(int g=0; g<triggersOfType.second.size(); ++g)
+		{
+			Trigger & trig = triggersOfType.second[g];
+			trig.header = &retrieveTrigger(retrieveLine(trig.line));
+
+			//body ends before next trigger or at the end of file
+			LinePointer lp = trig.line;
+			for(++lp; lp.isValid(); ++lp)
+			{
+				auto lineIt = scripts.find(lp);
+				if(isATrigger(lineIt->second))
+					break;
+				trig.body.push_back(CompiledLine(lineIt->first, &lineIt->second));
+			}
+
+			//identifiers made only of numbers can be matched by lookup instead of evaluation
+			trig.constantIdentifier = trig.header->identifier.is_initialized();
+			if(trig.constantIdentifier)
+			{
+				for(const ERM::TIdentifierInternal & item : trig.header->identifier.get())
+				{
+					const ERM::TIexp * iexp = boost::get<ERM::TIexp>(&item);
+					const int * constant = iexp ? boost::get<int>(iexp) : nullptr;
+					if(!constant)
+					{
+						trig.constantIdentifier = false;
+						trig.identifierValues.clear();
+						break;
+					}
+					trig.identifierValues.push_back(*constant);
+				}
+			}
+
+			if(trig.constantIdentifier)
+				typeIndex.byIdentifier[trig.identifierValues].push_back(g);
+			else
+				typeIndex.alwaysChecked.push_back(g);
+		}
+	}
 }
 
 ERMInterpreter::ERMInterpreter()
@@ -487,16 +537,10 @@ void ERMInterpreter::executeTrigger(VERMInterpreter::Trigger & trig, int funNum,
 	else
 		curFunc = getFuncVars(0);
 
-	//skip the first line
-	LinePointer lp = trig.line;
-	++lp;
-	for(; lp.isValid(); ++lp)
+	for(const CompiledLine & bodyLine : trig.body)
 	{
-		ERM::TLine curLine = retrieveLine(lp);
-		if(isATrigger(curLine))
-			break;
-
-		executeLine(lp);
+		logGlobal->debug("Executing line %d (internal %d) from %s", bodyLine.pointer.realLineNum, bodyLine.pointer.lineNum, bodyLine.pointer.file->filename);
+		executeLine(*bodyLine.line);
 	}
 
 	curFunc = nullptr;
@@ -1464,8 +1508,8 @@ struct LineExec : boost::static_visitor<>
 
 void ERMInterpreter::executeLine( const LinePointer & lp )
 {
-	logGlobal->debug("Executing line %d (internal %d) from %s", getRealLine(lp), lp.lineNum, lp.file->filename);
-	executeLine(scripts[lp]);
+	logGlobal->debug("Executing line %d (internal %d) from %s", lp.realLineNum, lp.lineNum, lp.file->filename);
+	executeLine(retrieveLine(lp));
 }
 
 void ERMInterpreter::executeLine(const ERM::TLine &line)
@@ -1793,14 +1837,55 @@ void ERMInterpreter::executeTriggerType(VERMInterpreter::TriggerType tt, bool pr
 	tim.ermEnv = this;
 	tim.matchToIt = identifier;
 	std::vector<Trigger> & triggersToTry = triggerList[tt];
-	for(int g=0; g<triggersToTry.size(); ++g)
+	for(int g : findTriggerCandidates(tt, pre, identifier))
+	{
+		Trigger & trig = triggersToTry[g];
+
+		//constant identifiers were already matched by lookup, others are evaluated now as they may depend on variables
+		bool matches = trig.constantIdentifier ? tim.checkCondition(&trig) : tim.tryMatch(&trig);
+		if(matches)
+		{
+			curTrigger = &trig;
+			executeTrigger(trig, HLP::calcFunNum(tt, identifier), funParams);
+		}
+	}
+}
+
+std::vector<int> ERMInterpreter::findTriggerCandidates(VERMInterpreter::TriggerType tt, bool pre, const TIDPattern & identifier)
+{
+	TtriggerIndexType & index = pre ? triggerIndex : postTriggerIndex;
+
+	auto typeIndex = index.find(tt);
+	if(typeIndex == index.end())
+		return std::vector<int>();
+
+	std::vector<int> ret = typeIndex->second.alwaysChecked;
+
+	for(auto & pattern : identifier)
 	{
-		if(tim.tryMatch(&triggersToTry[g]))
+		if(pattern.second.size() == pattern.first)
+		{
+			auto found = typeIndex->second.byIdentifier.find(pattern.second);
+			if(found != typeIndex->second.byIdentifier.end())
+				vstd::concatenate(ret, found->second);
+		}
+		else
 		{
-			curTrigger = &triggersToTry[g];
-			executeTrigger(triggersToTry[g], HLP::calcFunNum(tt, identifier), funParams);
+			//pattern is compared with identifier of given length only on its own length, same as in TriggerIdentifierMatch
+			for(auto & entry : typeIndex->second.byIdentifier)
+			{
+				const std::vector<int> & values = entry.first;
+				if(values.size() == pattern.first && pattern.second.size() <= values.size()
+					&& std::equal(pattern.second.begin(), pattern.second.end(), values.begin()))
+					vstd::concatenate(ret, entry.second);
+			}
 		}
 	}
+
+	//triggers are executed in the same order as they appear in scripts
+	std::sort(ret.begin(), ret.end());
+	ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+	return ret;
 }
 
 void ERMInterpreter::executeTriggerType(const char *trigger, int id)
@@ -2018,11 +2103,11 @@ bool TriggerIdentifierMatch::tryMatch( Trigger * interptrig ) const
 {
 	bool ret = true;
 
-	const ERM::TTriggerBase & trig = ERMInterpreter::retrieveTrigger(ermEnv->retrieveLine(interptrig->line));
+	const ERM::TTriggerBase & trig = interptrig->header ? *interptrig->header : ERMInterpreter::retrieveTrigger(ermEnv->retrieveLine(interptrig->line));
 	if(trig.identifier.is_initialized())
 	{
 
-		ERM::Tidentifier tid = trig.identifier.get();
+		const ERM::Tidentifier & tid = trig.identifier.get();
 		std::map< int, std::vector<int> >::const_iterator it = matchToIt.find(tid.size());
 		if(it == matchToIt.end())
 			ret = false;
@@ -2059,6 +2144,14 @@ bool TriggerIdentifierMatch::tryMatch( Trigger * interptrig ) const
 		return false;
 }
 
+bool TriggerIdentifierMatch::checkCondition( Trigger * interptrig ) const
+{
+	const ERM::TTriggerBase & trig = *interptrig->header;
+	if(trig.condition.is_initialized())
+		return ermEnv->checkCondition(trig.condition.get());
+	return true;
+}
+
 VERMInterpreter::ERMEnvironment::ERMEnvironment()
 {
 	for(int g=0; g<NUM_QUICKS; ++g)
@@ -275,15 +275,41 @@ namespace VERMInterpreter
 		std::vector<LexicalPtr> stack;
 	};
 
+	//line of script together with its already parsed content
+	struct CompiledLine
+	{
+		LinePointer pointer;
+		const ERM::TLine * line; //non-owning, points into ERMInterpreter::scripts
+
+		CompiledLine(const LinePointer & lp, const ERM::TLine * tl) : pointer(lp), line(tl)
+		{}
+	};
+
 	struct Trigger
 	{
 		LinePointer line;
 		TriggerLocalVars ermLocalVars;
 		Stack * stack; //where we are stuck at execution
-		Trigger() : stack(nullptr)
+
+		//filled once by ERMInterpreter::compileTriggers so that execution doesn't need to search for lines
+		const ERM::TTriggerBase * header; //non-owning
+		std::vector<CompiledLine> body; //lines up to the next trigger
+		bool constantIdentifier; //identifier contains only numbers, they are stored in identifierValues
+		std::vector<int> identifierValues;
+
+		Trigger() : stack(nullptr), header(nullptr), constantIdentifier(false)
 		{}
 	};
 
+	//dispatch table for triggers of one type, indices refer to ERMInterpreter::triggers (or postTriggers)
+	struct TriggerIndex
+	{
+		//triggers with constant identifier, by values of that identifier
+		std::map<std::vector<int>, std::vector<int> > byIdentifier;
+		//triggers without identifier or with identifier containing variables - they have to be always checked
+		std::vector<int> alwaysChecked;
+	};
+
 
 	//verm goodies
 	struct VSymbol
@@ -602,6 +628,8 @@ struct TriggerIdentifierMatch
 	static const int MAX_SUBIDENTIFIERS = 16;
 	ERMInterpreter * ermEnv;
 	bool tryMatch(VERMInterpreter::Trigger * interptrig) const;
+	//same as tryMatch but skips identifier check, for triggers already selected from TriggerIndex
+	bool checkCondition(VERMInterpreter::Trigger * interptrig) const;
 };
 
 struct IexpValStr
@@ -793,6 +821,8 @@ class ERMInterpreter : public CScriptingModule
 	VERMInterpreter::ERMEnvironment * ermGlobalEnv;
 	typedef std::map<VERMInterpreter::TriggerType, std::vector<VERMInterpreter::Trigger> > TtriggerListType;
 	TtriggerListType triggers, postTriggers;
+	typedef std::map<VERMInterpreter::TriggerType, VERMInterpreter::TriggerIndex> TtriggerIndexType;
+	TtriggerIndexType triggerIndex, postTriggerIndex;
 	VERMInterpreter::Trigger * curTrigger;
 	VERMInterpreter::FunctionLocalVars * curFunc;
 	static const int TRIG_FUNC_NUM = 30000;
@@ -810,6 +840,7 @@ class ERMInterpreter : public CScriptingModule
 	void executeLine(const VERMInterpreter::LinePointer & lp);
 	void executeLine(const ERM::TLine &line);
 	void executeTrigger(VERMInterpreter::Trigger & trig, int funNum = -1, std::vector<int> funParams=std::vector<int>());
+	void compileTriggers(TtriggerListType & triggerList, TtriggerIndexType & index);
 	static bool isCMDATrigger(const ERM::Tcommand & cmd);
 	static bool isATrigger(const ERM::TLine & line);
 	static ERM::EVOtions getExpType(const ERM::TVOption & opt);
@@ -826,6 +857,7 @@ public:
 	void executeTriggerType(VERMInterpreter::TriggerType tt, bool pre, const TIDPattern & identifier, const std::vector<int> &funParams=std::vector<int>()); //use this to run triggers
 	void executeTriggerType(const char *trigger, int id); //convenience version of above, for pre-trigger when there is only one argument
 	void executeTriggerType(const char *trigger); //convenience version of above, for pre-trigger when there are no args
+	std::vector<int> findTriggerCandidates(VERMInterpreter::TriggerType tt, bool pre, const TIDPattern & identifier); //indices of triggers that may match identifier, in script order
 	void setCurrentlyVisitedObj(int3 pos); //sets v998 - v1000 to given value
 	void scanForScripts();
 
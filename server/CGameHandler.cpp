@@ -122,6 +122,32 @@ static inline double distance(int3 a, int3 b)
 {
 	return std::sqrt((double)(a.x-b.x)*(a.x-b.x) + (a.y-b.y)*(a.y-b.y));
 }
+
+//row runs of all tiles of fog of war map, or only of these which are still hidden
+static std::vector<TileRun> fogOfWarRuns(const std::vector<std::vector<std::vector<ui8> > > & fow, bool hiddenOnly)
+{
+	std::vector<TileRun> runs;
+	if(fow.empty() || fow[0].empty())
+		return runs;
+
+	const int width = fow.size(), height = fow[0].size(), levels = fow[0][0].size();
+	for(int z = 0; z < levels; z++)
+	{
+		for(int y = 0; y < height; y++)
+		{
+			for(int x = 0; x < width; x++)
+			{
+				if(hiddenOnly && fow[x][y][z])
+					continue;
+				if(!runs.empty() && runs.back().start.z == z && runs.back().start.y == y && runs.back().start.x + runs.back().length == x)
+					runs.back().length++;
+				else
+					runs.push_back(TileRun(int3(x, y, z), 1));
+			}
+		}
+	}
+	return runs;
+}
 static void giveExp(BattleResult &r)
 {
 	if (r.winner > 1)
@@ -1708,12 +1734,7 @@ void CGameHandler::newTurn()
 				fw.mode = 1;
 				fw.player = player;
 				// find all hidden tiles
-				const auto & fow = getPlayerTeam(player)->fogOfWarMap;
-				for (size_t i=0; i<fow.size(); i++)
-					for (size_t j=0; j<fow.at(i).size(); j++)
-						for (size_t k=0; k<fow.at(i).at(j).size(); k++)
-							if (!fow.at(i).at(j).at(k))
-								fw.tiles.insert(int3(i,j,k));
+				fw.runs = fogOfWarRuns(getPlayerTeam(player)->fogOfWarMap, true);
 
 				sendAndApply (&fw);
 			}
@@ -2209,6 +2230,48 @@ bool CGameHandler::moveHero(ObjectInstanceID hid, int3 dst, ui8 teleporting, boo
 	}
 }
 
+bool CGameHandler::moveHeroPath(ObjectInstanceID hid, const std::vector<std::pair<int3, bool>> & steps, PlayerColor asker)
+{
+	if(steps.empty())
+		COMPLAIN_RET("Hero path is empty!");
+
+	const CGHeroInstance * hero = getHero(hid);
+	if(!hero)
+		COMPLAIN_RET("No such hero!");
+
+	//every step takes at least the cheapest move, except the last one which may take all remaining points
+	//movement points are scaled by ratio of land and water maximum when boarding or leaving boat
+	auto ti = make_unique<TurnInfo>(hero);
+	const si64 minCost = ti->getMinMovementCost();
+	const si64 landPoints = ti->getMaxMovePoints(EPathfindingLayer::LAND);
+	const si64 waterPoints = ti->getMaxMovePoints(EPathfindingLayer::SAIL);
+	const si64 maxPoints = std::max<si64>({hero->movement, landPoints, waterPoints}) * std::max(landPoints, waterPoints) / std::max<si64>(1, std::min(landPoints, waterPoints));
+	if(minCost > 0 && static_cast<si64>(steps.size()) > maxPoints / minCost + 1)
+		COMPLAIN_RETF("Hero path of %d steps is longer than hero can move!", steps.size());
+
+	for(auto & step : steps)
+	{
+		if(!moveHero(hid, step.first, 0, step.second, asker))
+			return false;
+
+		//stop at first interruption and let client decide how to continue:
+		//hero was lost or stopped before destination (e.g. blocking visit)
+		const CGHeroInstance * h = getHero(hid);
+		if(!h || h->pos != step.first)
+			return true;
+
+		//battle, dialog or any other query started by movement
+		if(queries.topQuery(h->tempOwner))
+			return true;
+
+		//hero has visited object on destination tile
+		if(getTile(h->visitablePos())->visitableObjects.size() > 1)
+			return true;
+	}
+
+	return true;
+}
+
 bool CGameHandler::teleportHero(ObjectInstanceID hid, ObjectInstanceID dstid, ui8 source, PlayerColor asker)
 {
 	const CGHeroInstance *h = getHero(hid);
@@ -6215,16 +6278,7 @@ void CGameHandler::handleCheatCode(std::string & cheat, PlayerColor player, cons
 		FoWChange fc;
 		fc.mode = (cheat == "vcmieagles" ? 1 : 0);
 		fc.player = player;
-		const auto & fowMap = gs->getPlayerTeam(player)->fogOfWarMap;
-		auto hlp_tab = new int3[gs->map->width * gs->map->height * (gs->map->twoLevel ? 2 : 1)];
-		int lastUnc = 0;
-		for (int i = 0; i < gs->map->width; i++)
-			for (int j = 0; j < gs->map->height; j++)
-				for (int k = 0; k < (gs->map->twoLevel ? 2 : 1); k++)
-					if (!fowMap.at(i).at(j).at(k) || !fc.mode)
-						hlp_tab[lastUnc++] = int3(i, j, k);
-		fc.tiles.insert(hlp_tab, hlp_tab + lastUnc);
-		delete [] hlp_tab;
+		fc.runs = fogOfWarRuns(gs->getPlayerTeam(player)->fogOfWarMap, fc.mode);
 		sendAndApply(&fc);
 	}
 	else
@@ -95,6 +95,12 @@ bool MoveHero::applyGh( CGameHandler *gh )
 	return gh->moveHero(hid,dest,0,transit,gh->getPlayerAt(c));
 }
 
+bool MoveHeroPath::applyGh( CGameHandler *gh )
+{
+	ERROR_IF_NOT_OWNS(hid);
+	return gh->moveHeroPath(hid,steps,gh->getPlayerAt(c));
+}
+
 bool CastleTeleportHero::applyGh( CGameHandler *gh )
 {
 	ERROR_IF_NOT_OWNS(hid);
@@ -0,0 +1,147 @@
+/*
+ * CGameStateJournalTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/CGameStateJournal.h"
+
+struct CGameStateJournalTest : testing::Test
+{
+	CGameStateJournal subject;
+};
+
+TEST_F(CGameStateJournalTest, empty)
+{
+	EXPECT_EQ(subject.getVersion(), 0);
+	EXPECT_TRUE(subject.getChangesSince(0).empty());
+}
+
+TEST_F(CGameStateJournalTest, mergesChangesSinceVersion)
+{
+	subject.beginEntry();
+	subject.recordTile(int3(1, 2, 0));
+	subject.endEntry();
+
+	const ui64 version = subject.getVersion();
+
+	subject.beginEntry();
+	subject.recordObject(ObjectInstanceID(5));
+	subject.recordTile(int3(3, 4, 0));
+	subject.endEntry();
+
+	subject.beginEntry();
+	subject.recordPlayer(PlayerColor(1));
+	subject.endEntry();
+
+	EXPECT_EQ(subject.getVersion(), version + 2);
+
+	GameStateChanges changes = subject.getChangesSince(version);
+	EXPECT_FALSE(changes.everything);
+	EXPECT_EQ(changes.tiles.size(), 1);
+	EXPECT_EQ(changes.tiles.count(int3(3, 4, 0)), 1);
+	EXPECT_EQ(changes.objects.count(ObjectInstanceID(5)), 1);
+	EXPECT_EQ(changes.players.count(PlayerColor(1)), 1);
+
+	EXPECT_EQ(subject.getChangesSince(0).tiles.size(), 2);
+	EXPECT_TRUE(subject.getChangesSince(subject.getVersion()).empty());
+}
+
+TEST_F(CGameStateJournalTest, unrecordedEntryChangesEverything)
+{
+	subject.beginEntry();
+	subject.endEntry();
+
+	EXPECT_TRUE(subject.getChangesSince(0).everything);
+}
+
+TEST_F(CGameStateJournalTest, droppedEntriesChangeEverything)
+{
+	for(size_t i = 0; i <= CGameStateJournal::MAX_ENTRIES; i++)
+	{
+		subject.beginEntry();
+		subject.recordTile(int3(i % 16, 0, 0));
+		subject.endEntry();
+	}
+
+	EXPECT_TRUE(subject.getChangesSince(0).everything);
+	EXPECT_FALSE(subject.getChangesSince(1).everything);
+}
+
+TEST_F(CGameStateJournalTest, tileChangesSinceVersion)
+{
+	EXPECT_FALSE(subject.hasTileChangesSince(0));
+
+	subject.beginEntry();
+	subject.recordTile(int3(1, 2, 0));
+	subject.endEntry();
+
+	const ui64 version = subject.getVersion();
+
+	subject.beginEntry();
+	subject.recordPlayer(PlayerColor(1));
+	subject.endEntry();
+
+	EXPECT_TRUE(subject.hasTileChangesSince(0));
+	EXPECT_FALSE(subject.hasTileChangesSince(version));
+	EXPECT_FALSE(subject.hasTileChangesSince(subject.getVersion()));
+
+	subject.beginEntry();
+	subject.endEntry();
+
+	EXPECT_TRUE(subject.hasTileChangesSince(version)); //unrecorded entry may have changed tiles as well
+}
+
+TEST_F(CGameStateJournalTest, filteredTileChanges)
+{
+	subject.beginEntry();
+	subject.recordTile(int3(1, 2, 0));
+	subject.recordTile(int3(5, 5, 1));
+	subject.endEntry();
+
+	auto onSurface = [](const int3 & tile){ return tile.z == 0; };
+	auto onRow = [](const int3 & tile){ return tile.y == 7; };
+	EXPECT_TRUE(subject.hasTileChangesSince(0, onSurface));
+	EXPECT_FALSE(subject.hasTileChangesSince(0, onRow));
+
+	subject.beginEntry();
+	subject.endEntry();
+
+	EXPECT_TRUE(subject.hasTileChangesSince(0, onRow)); //unrecorded entry is not filtered
+}
+
+TEST_F(CGameStateJournalTest, bonusOwners)
+{
+	subject.beginEntry();
+	subject.recordBonuses(ObjectInstanceID(3));
+	subject.endEntry();
+
+	GameStateChanges changes = subject.getChangesSince(0);
+	EXPECT_FALSE(changes.empty());
+	EXPECT_EQ(changes.bonusOwners.count(ObjectInstanceID(3)), 1);
+	EXPECT_FALSE(subject.hasTileChangesSince(0));
+}
+
+TEST_F(CGameStateJournalTest, tileChangesMatchMergedChanges)
+{
+	for(size_t i = 0; i <= CGameStateJournal::MAX_ENTRIES; i++)
+	{
+		subject.beginEntry();
+		if(i % 100 == 0)
+			subject.recordTile(int3(i % 16, 0, 0));
+		else
+			subject.recordObject(ObjectInstanceID(i));
+		subject.endEntry();
+	}
+
+	for(ui64 version = 0; version <= subject.getVersion(); version += 7)
+	{
+		GameStateChanges changes = subject.getChangesSince(version);
+		EXPECT_EQ(subject.hasTileChangesSince(version), changes.everything || !changes.tiles.empty()) << "since version " << version;
+	}
+}
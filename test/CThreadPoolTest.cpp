@@ -0,0 +1,55 @@
+/*
+ * CThreadPoolTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/CThreadHelper.h"
+
+TEST(CThreadPoolTest, runsAllTasks)
+{
+	CThreadPool pool(4);
+
+	for(int run = 0; run < 10; run++)
+	{
+		std::vector<int> results(100, 0);
+		std::vector<Task> tasks;
+		for(int i = 0; i < results.size(); i++)
+			tasks.push_back([&results, i](){ results[i] = i + 1; });
+
+		pool.run(tasks);
+
+		for(int i = 0; i < results.size(); i++)
+			EXPECT_EQ(results[i], i + 1);
+	}
+}
+
+TEST(CThreadPoolTest, rethrowsTaskException)
+{
+	CThreadPool pool(4);
+
+	std::atomic<int> finished(0);
+	std::vector<Task> tasks;
+	for(int i = 0; i < 50; i++)
+	{
+		tasks.push_back([&finished, i]()
+		{
+			if(i % 10 == 3)
+				throw std::runtime_error("task failed");
+			finished++;
+		});
+	}
+
+	EXPECT_THROW(pool.run(tasks), std::runtime_error);
+	EXPECT_EQ(finished, 45);
+
+	//pool is still usable after failed run
+	std::vector<Task> nextTasks = {[&finished](){ finished++; }};
+	pool.run(nextTasks);
+	EXPECT_EQ(finished, 46);
+}
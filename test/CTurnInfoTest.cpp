@@ -0,0 +1,86 @@
+/*
+ * CTurnInfoTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/CPathfinder.h"
+#include "../lib/CHeroHandler.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/mapping/CMapDefines.h"
+
+/// tile cost computed the way it was done before it was precomputed in TurnInfo
+static int tileCostFormula(const CGHeroInstance & hero, const TerrainTile & dest, const TerrainTile & from)
+{
+	int ret = GameConstants::BASE_MOVEMENT_COST;
+
+	if(dest.roadType != ERoadType::NO_ROAD && from.roadType != ERoadType::NO_ROAD)
+	{
+		switch(std::min(dest.roadType, from.roadType))
+		{
+		case ERoadType::DIRT_ROAD:
+			ret = 75;
+			break;
+		case ERoadType::GRAVEL_ROAD:
+			ret = 65;
+			break;
+		case ERoadType::COBBLESTONE_ROAD:
+			ret = 50;
+			break;
+		default:
+			break;
+		}
+	}
+	else if(hero.getNativeTerrain() != from.terType && !hero.hasBonusOfType(Bonus::NO_TERRAIN_PENALTY, from.terType))
+	{
+		ret = VLC->heroh->terrCosts[from.terType];
+		ret -= hero.valOfBonuses(Selector::typeSubtype(Bonus::SECONDARY_SKILL_PREMY, SecondarySkill::PATHFINDING));
+		vstd::amax(ret, GameConstants::BASE_MOVEMENT_COST);
+	}
+	return ret;
+}
+
+static void expectFormulaCosts(const CGHeroInstance & hero)
+{
+	TurnInfo ti(&hero);
+
+	//last road type is not known
+	for(int terrain = 0; terrain < ETerrainType::ROCK; terrain++)
+	{
+		for(int fromRoad = ERoadType::NO_ROAD; fromRoad <= ERoadType::COBBLESTONE_ROAD + 1; fromRoad++)
+		{
+			for(int destRoad = ERoadType::NO_ROAD; destRoad <= ERoadType::COBBLESTONE_ROAD + 1; destRoad++)
+			{
+				TerrainTile from, dest;
+				from.terType = ETerrainType(terrain);
+				from.roadType = ERoadType::ERoadType(fromRoad);
+				dest.terType = ETerrainType::GRASS;
+				dest.roadType = ERoadType::ERoadType(destRoad);
+
+				EXPECT_EQ(ti.getTileCost(dest, from), tileCostFormula(hero, dest, from))
+					<< "terrain " << terrain << ", roads " << fromRoad << " and " << destRoad;
+				EXPECT_EQ(ti.getMovementCost(dest, from, false), ti.getTileCost(dest, from));
+			}
+		}
+	}
+}
+
+TEST(CTurnInfoTest, costsMatchFormula)
+{
+	CGHeroInstance hero;
+	expectFormulaCosts(hero);
+}
+
+TEST(CTurnInfoTest, costsMatchFormulaWithBonuses)
+{
+	CGHeroInstance hero;
+	hero.addNewBonus(std::make_shared<Bonus>(Bonus::PERMANENT, Bonus::SECONDARY_SKILL_PREMY, Bonus::SECONDARY_SKILL, 50, SecondarySkill::PATHFINDING, SecondarySkill::PATHFINDING));
+	hero.addNewBonus(std::make_shared<Bonus>(Bonus::PERMANENT, Bonus::NO_TERRAIN_PENALTY, Bonus::ARTIFACT, 0, 0, ETerrainType::SWAMP));
+	expectFormulaCosts(hero);
+}
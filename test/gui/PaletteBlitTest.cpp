@@ -0,0 +1,142 @@
+/*
+ * PaletteBlitTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../../client/gui/PaletteBlit.h"
+
+namespace
+{
+	/// same memory layout as SDL_Color
+	struct Color
+	{
+		ui8 r, g, b, a;
+	};
+
+	typedef PaletteBlit::Layout<2, 1, 0, 3> TLayoutBGRA;
+	typedef PaletteBlit::Layout<1, 2, 3, 0> TLayoutARGB;
+}
+
+class PaletteBlitTest : public testing::Test
+{
+protected:
+	std::mt19937 rand;
+	std::vector<Color> palette;
+	std::vector<ui8> source;
+	std::vector<ui8> target;
+
+	PaletteBlitTest()
+		: rand(1337), palette(256)
+	{
+	}
+
+	/// alpha 0, 128 and 255 have special handling in the scalar code, so they are given extra weight
+	void randomize(size_t pixels)
+	{
+		std::uniform_int_distribution<int> byte(0, 255);
+		const ui8 specialAlpha[] = {0, 128, 255};
+
+		for(Color & color : palette)
+		{
+			color.r = byte(rand);
+			color.g = byte(rand);
+			color.b = byte(rand);
+			color.a = byte(rand) % 2 ? specialAlpha[byte(rand) % 3] : byte(rand);
+		}
+
+		source.resize(pixels);
+		for(ui8 & index : source)
+			index = byte(rand);
+
+		target.resize(pixels * 4);
+		for(ui8 & value : target)
+			value = byte(rand);
+	}
+
+	template<typename TLayout>
+	void checkRows()
+	{
+		for(int iteration = 0; iteration < 100; iteration++)
+		{
+			// odd lengths check both vectorized part and the tail
+			const int count = 1 + iteration * 7 % 67;
+			randomize(count);
+
+			std::vector<ui8> expected = target;
+			PaletteBlit::blitRowScalar<TLayout>(source.data(), expected.data(), count, palette.data());
+			PaletteBlit::blitRow<TLayout>(source.data(), target.data(), count, palette.data());
+
+			ASSERT_EQ(expected, target) << "row of " << count << " pixels";
+		}
+	}
+};
+
+TEST_F(PaletteBlitTest, specialAlphaValues)
+{
+	palette[0] = Color{200, 100, 50, 0};
+	palette[1] = Color{200, 100, 50, 128};
+	palette[2] = Color{200, 100, 50, 255};
+	palette[3] = Color{200, 100, 50, 64};
+
+	const std::vector<ui8> row = {0, 1, 2, 3};
+	std::vector<ui8> pixels(row.size() * 4);
+	for(size_t i = 0; i < row.size(); i++)
+	{
+		pixels[i * 4 + TLayoutBGRA::r] = 10;
+		pixels[i * 4 + TLayoutBGRA::g] = 20;
+		pixels[i * 4 + TLayoutBGRA::b] = 30;
+		pixels[i * 4 + TLayoutBGRA::a] = 40;
+	}
+
+	PaletteBlit::blitRow<TLayoutBGRA>(row.data(), pixels.data(), row.size(), palette.data());
+
+	const std::vector<ui8> expected =
+	{
+		30, 20, 10, 40, // transparent - unchanged
+		40, 60, 105, 255, // half transparent - average
+		50, 100, 200, 255, // opaque - source
+		35, 40, 57, 255 // generic formula
+	};
+	EXPECT_EQ(pixels, expected);
+}
+
+TEST_F(PaletteBlitTest, matchesScalarBGRA)
+{
+	checkRows<TLayoutBGRA>();
+}
+
+TEST_F(PaletteBlitTest, matchesScalarARGB)
+{
+	checkRows<TLayoutARGB>();
+}
+
+// benchmark, not run by default; use --gtest_also_run_disabled_tests
+TEST_F(PaletteBlitTest, DISABLED_timing)
+{
+	// one 800x600 screen of adventure map objects
+	const int width = 800;
+	const int height = 600;
+	randomize(width * height);
+
+	std::vector<ui8> expected = target;
+
+	auto start = boost::posix_time::microsec_clock::universal_time();
+	for(int y = 0; y < height; y++)
+		PaletteBlit::blitRowScalar<TLayoutBGRA>(source.data() + y * width, expected.data() + y * width * 4, width, palette.data());
+	auto scalarDuration = boost::posix_time::microsec_clock::universal_time() - start;
+
+	start = boost::posix_time::microsec_clock::universal_time();
+	for(int y = 0; y < height; y++)
+		PaletteBlit::blitRow<TLayoutBGRA>(source.data() + y * width, target.data() + y * width * 4, width, palette.data());
+	auto duration = boost::posix_time::microsec_clock::universal_time() - start;
+
+	logGlobal->info("Blit of %dx%d paletted pixels took %d us, scalar code took %d us", width, height, duration.total_microseconds(), scalarDuration.total_microseconds());
+
+	EXPECT_EQ(expected, target);
+}
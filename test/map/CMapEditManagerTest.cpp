@@ -166,3 +166,128 @@ TEST(MapManager, DrawTerrain_View)
 		throw;
 	}
 }
+
+TEST(MapManager, DrawTerrain_ValidationCache)
+{
+	try
+	{
+		// Paints the same random areas: without cached validation results, with empty cache and with cache filled by previous run
+		auto paint = [](CMap * map)
+		{
+			static const ETerrainType types[] = { ETerrainType::GRASS, ETerrainType::SNOW, ETerrainType::LAVA, ETerrainType::SAND,
+												ETerrainType::DIRT, ETerrainType::ROUGH, ETerrainType::SWAMP };
+			CRandomGenerator gen;
+			gen.setSeed(42);
+			CRandomGenerator areas;
+			areas.setSeed(1337);
+
+			auto editManager = map->getEditManager();
+			editManager->clearTerrain(&gen);
+			for(int i = 0; i < 30; ++i)
+			{
+				int3 pos(areas.nextInt(0, map->width - 9), areas.nextInt(0, map->height - 9), 0);
+				editManager->getTerrainSelection().selectRange(MapRect(pos, areas.nextInt(1, 8), areas.nextInt(1, 8)));
+				editManager->drawTerrain(types[areas.nextInt(ARRAY_COUNT(types) - 1)], &gen);
+			}
+		};
+
+		auto createMap = []()
+		{
+			auto map = make_unique<CMap>();
+			map->width = 36;
+			map->height = 36;
+			map->initTerrain();
+			return map;
+		};
+
+		auto uncached = createMap();
+		auto first = createMap();
+		auto second = createMap();
+
+		CTerrainViewPatternConfig::setValidationCacheEnabled(false);
+		paint(uncached.get());
+		CTerrainViewPatternConfig::setValidationCacheEnabled(true);
+		paint(first.get());
+		paint(second.get());
+
+		for(const CMap * cached : {first.get(), second.get()})
+		{
+			for(int x = 0; x < uncached->width; ++x)
+			{
+				for(int y = 0; y < uncached->height; ++y)
+				{
+					const auto & expectedTile = uncached->getTile(int3(x, y, 0));
+					const auto & tile = cached->getTile(int3(x, y, 0));
+					EXPECT_EQ(expectedTile.terType, tile.terType);
+					EXPECT_EQ(expectedTile.terView, tile.terView);
+					EXPECT_EQ(expectedTile.extTileFlags, tile.extTileFlags);
+				}
+			}
+		}
+	}
+	catch(const std::exception & e)
+	{
+		CTerrainViewPatternConfig::setValidationCacheEnabled(true);
+		FAIL()<<e.what();
+		throw;
+	}
+}
+
+TEST(MapManager, DrawTerrain_Batch)
+{
+	try
+	{
+		// Areas lie far enough apart that their invalidated views do not overlap, so batched drawing must match sequential drawing
+		static const ETerrainType types[] = { ETerrainType::SNOW, ETerrainType::LAVA, ETerrainType::SWAMP };
+		static const int rows[] = { 2, 20, 38 };
+
+		auto createMap = []()
+		{
+			auto map = make_unique<CMap>();
+			map->width = 48;
+			map->height = 48;
+			map->initTerrain();
+			return map;
+		};
+
+		auto paint = [](CMap * map, bool batch)
+		{
+			CRandomGenerator gen;
+			gen.setSeed(42);
+
+			auto editManager = map->getEditManager();
+			editManager->clearTerrain(&gen);
+			if(batch)
+				editManager->startTerrainBatch();
+			for(int i = 0; i < ARRAY_COUNT(types); ++i)
+			{
+				editManager->getTerrainSelection().selectRange(MapRect(int3(3 + 4 * i, rows[i], 0), 10, 7));
+				editManager->drawTerrain(types[i], &gen);
+			}
+			if(batch)
+				editManager->finishTerrainBatch(&gen);
+		};
+
+		auto sequential = createMap();
+		auto batched = createMap();
+		paint(sequential.get(), false);
+		paint(batched.get(), true);
+
+		for(int x = 0; x < sequential->width; ++x)
+		{
+			for(int y = 0; y < sequential->height; ++y)
+			{
+				const auto & expectedTile = sequential->getTile(int3(x, y, 0));
+				const auto & tile = batched->getTile(int3(x, y, 0));
+				EXPECT_EQ(expectedTile.terType, tile.terType);
+				EXPECT_EQ(expectedTile.terView, tile.terView);
+				EXPECT_EQ(expectedTile.extTileFlags, tile.extTileFlags);
+			}
+		}
+	}
+	catch(const std::exception & e)
+	{
+		FAIL()<<e.what();
+		throw;
+	}
+}
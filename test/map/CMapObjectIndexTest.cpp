@@ -0,0 +1,245 @@
+/*
+ * CMapObjectIndexTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapObjects/MapObjects.h"
+#include "../lib/mapObjects/ObjectTemplate.h"
+#include "../lib/CHeroHandler.h"
+#include "../lib/CGameState.h"
+#include "../lib/NetPacks.h"
+#include "../lib/JsonNode.h"
+#include "../lib/serializer/CMemorySerializer.h"
+
+class CMapObjectIndexTest : public testing::Test
+{
+protected:
+	CGameState gs;
+	CMap * map;
+
+	CMapObjectIndexTest()
+	{
+		map = new CMap();
+		map->width = 36;
+		map->height = 20;
+		map->twoLevel = true;
+		map->initTerrain();
+		gs.map = map;
+	}
+
+	/// mask uses the same format as object templates in mods, last character of last row is bottom-right corner
+	CGObjectInstance * addObject(const int3 & pos, const std::vector<std::string> & mask, Obj ID = Obj::RESOURCE)
+	{
+		JsonNode node;
+		for(const std::string & row : mask)
+		{
+			JsonNode line(JsonNode::DATA_STRING);
+			line.String() = row;
+			node["mask"].Vector().push_back(line);
+		}
+
+		auto obj = new CGObjectInstance();
+		obj->ID = ID;
+		obj->id = ObjectInstanceID(map->objects.size());
+		obj->instanceName = "object_" + std::to_string(obj->id.getNum());
+		obj->pos = pos;
+		obj->appearance.readJson(node, false);
+		map->addNewObject(obj);
+		return obj;
+	}
+
+	std::set<const CGObjectInstance *> query(const CMap * target, const int3 & pos, int radius, Obj type = Obj::NO_OBJ)
+	{
+		auto found = target->getObjectsInRange(pos, radius, type);
+		return std::set<const CGObjectInstance *>(found.begin(), found.end());
+	}
+
+	std::set<const CGObjectInstance *> query(const int3 & pos, int radius)
+	{
+		return query(map, pos, radius);
+	}
+
+	/// the same query done by scanning every tile
+	std::set<const CGObjectInstance *> scan(const CMap * target, const int3 & pos, int radius)
+	{
+		std::set<const CGObjectInstance *> ret;
+		for(int x = pos.x - radius; x <= pos.x + radius; x++)
+		{
+			for(int y = pos.y - radius; y <= pos.y + radius; y++)
+			{
+				const int3 tile(x, y, pos.z);
+				if(!target->isInTheMap(tile))
+					continue;
+				for(const CGObjectInstance * obj : target->getTile(tile).visitableObjects)
+				{
+					if(obj->visitablePos() == tile)
+						ret.insert(obj);
+				}
+			}
+		}
+		return ret;
+	}
+};
+
+TEST_F(CMapObjectIndexTest, added)
+{
+	auto visitable = addObject(int3(10, 10, 0), {"A"});
+	auto underground = addObject(int3(10, 10, 1), {"A"});
+	auto wide = addObject(int3(20, 10, 0), {"BBA"});
+	addObject(int3(11, 10, 0), {"BB"}, Obj::ROCKLANDS);
+
+	const std::set<const CGObjectInstance *> visitableOnly = {visitable};
+	EXPECT_EQ(query(int3(10, 10, 0), 1), visitableOnly);
+	EXPECT_EQ(query(int3(12, 10, 0), 2), visitableOnly);
+	EXPECT_TRUE(query(int3(12, 10, 0), 1).empty());
+
+	const std::set<const CGObjectInstance *> undergroundOnly = {underground};
+	EXPECT_EQ(query(int3(10, 10, 1), 0), undergroundOnly);
+
+	//found by visitable tile, not by other tiles of object
+	const std::set<const CGObjectInstance *> wideOnly = {wide};
+	EXPECT_EQ(query(int3(20, 10, 0), 0), wideOnly);
+	EXPECT_TRUE(query(int3(18, 10, 0), 0).empty());
+}
+
+TEST_F(CMapObjectIndexTest, filteredByType)
+{
+	auto resource = addObject(int3(10, 10, 0), {"A"});
+	auto mine = addObject(int3(12, 10, 0), {"A"}, Obj::MINE);
+	addObject(int3(30, 10, 0), {"A"}, Obj::MINE);
+
+	const std::set<const CGObjectInstance *> both = {resource, mine};
+	EXPECT_EQ(query(map, int3(11, 10, 0), 2), both);
+
+	const std::set<const CGObjectInstance *> mineOnly = {mine};
+	EXPECT_EQ(query(map, int3(11, 10, 0), 2, Obj::MINE), mineOnly);
+	const std::set<const CGObjectInstance *> resourceOnly = {resource};
+	EXPECT_EQ(query(map, int3(11, 10, 0), 2, Obj::RESOURCE), resourceOnly);
+	EXPECT_TRUE(query(map, int3(11, 10, 0), 2, Obj::TOWN).empty());
+}
+
+TEST_F(CMapObjectIndexTest, movedByChangeObjPos)
+{
+	auto obj = addObject(int3(5, 5, 0), {"A"});
+
+	ChangeObjPos cop;
+	cop.objid = obj->id;
+	cop.nPos = int3(30, 15, 1);
+	cop.applyGs(&gs);
+
+	EXPECT_TRUE(query(int3(5, 5, 0), 3).empty());
+	EXPECT_TRUE(query(int3(30, 15, 0), 3).empty());
+	const std::set<const CGObjectInstance *> moved = {obj};
+	EXPECT_EQ(query(int3(30, 15, 1), 0), moved);
+}
+
+TEST_F(CMapObjectIndexTest, removed)
+{
+	auto kept = addObject(int3(7, 7, 0), {"A"});
+	auto removed = addObject(int3(8, 7, 0), {"A"});
+
+	RemoveObject ro;
+	ro.id = removed->id;
+	ro.applyGs(&gs);
+
+	const std::set<const CGObjectInstance *> remaining = {kept};
+	EXPECT_EQ(query(int3(7, 7, 0), 5), remaining);
+}
+
+TEST_F(CMapObjectIndexTest, mapEdges)
+{
+	std::vector<CGObjectInstance *> corners =
+	{
+		addObject(int3(0, 0, 0), {"A"}),
+		addObject(int3(35, 0, 0), {"A"}),
+		addObject(int3(0, 19, 0), {"A"}),
+		addObject(int3(35, 19, 0), {"A"})
+	};
+	//visitable tile is left of the map, object can not be visited
+	addObject(int3(0, 10, 0), {"AV"});
+
+	for(const CGObjectInstance * corner : corners)
+	{
+		const std::set<const CGObjectInstance *> cornerOnly = {corner};
+		EXPECT_EQ(query(corner->visitablePos(), 3), cornerOnly);
+		EXPECT_EQ(query(corner->visitablePos(), 0), cornerOnly);
+	}
+
+	const std::set<const CGObjectInstance *> all(corners.begin(), corners.end());
+	EXPECT_EQ(query(int3(18, 10, 0), 100), all);
+	EXPECT_EQ(query(int3(-50, -50, 0), 1000), all);
+	EXPECT_TRUE(query(int3(-5, -5, 0), 4).empty());
+	EXPECT_TRUE(query(int3(40, 24, 0), 4).empty());
+	EXPECT_TRUE(query(int3(0, 10, 0), 2).empty());
+}
+
+TEST_F(CMapObjectIndexTest, negativeRadius)
+{
+	addObject(int3(10, 10, 0), {"A"});
+
+	EXPECT_TRUE(query(int3(10, 10, 0), -1).empty());
+	EXPECT_TRUE(query(int3(10, 10, 0), std::numeric_limits<int>::min()).empty());
+}
+
+TEST_F(CMapObjectIndexTest, matchesTileScan)
+{
+	std::mt19937 rand(1337);
+	std::uniform_int_distribution<int> x(-1, 36);
+	std::uniform_int_distribution<int> y(-1, 20);
+	std::uniform_int_distribution<int> z(0, 1);
+
+	for(int i = 0; i < 200; i++)
+	{
+		if(i % 3 == 0)
+			addObject(int3(x(rand), y(rand), z(rand)), {"BB"}, Obj::ROCKLANDS);
+		else
+			addObject(int3(x(rand), y(rand), z(rand)), {"VV", "BA"});
+	}
+
+	for(int i = 0; i < 200; i++)
+	{
+		const int3 pos(x(rand), y(rand), z(rand));
+		const int radius = i % 12;
+		EXPECT_EQ(query(pos, radius), scan(map, pos, radius)) << "query at " << pos.toString() << " radius " << radius;
+	}
+}
+
+TEST_F(CMapObjectIndexTest, rebuiltAfterLoad)
+{
+	std::mt19937 rand(42);
+	std::uniform_int_distribution<int> x(0, 35);
+	std::uniform_int_distribution<int> y(0, 19);
+	std::uniform_int_distribution<int> z(0, 1);
+
+	for(int i = 0; i < 100; i++)
+		addObject(int3(x(rand), y(rand), z(rand)), {"A"});
+
+	CMemorySerializer memory;
+	memory.oser & *map;
+	CMap loaded;
+	memory.iser & loaded;
+
+	for(int i = 0; i < 100; i++)
+	{
+		const int3 pos(x(rand), y(rand), z(rand));
+		const int radius = i % 8;
+
+		std::set<ObjectInstanceID> expected;
+		for(const CGObjectInstance * obj : query(pos, radius))
+			expected.insert(obj->id);
+
+		std::set<ObjectInstanceID> found;
+		for(const CGObjectInstance * obj : query(&loaded, pos, radius))
+			found.insert(obj->id);
+
+		EXPECT_EQ(found, expected) << "query at " << pos.toString() << " radius " << radius;
+		EXPECT_EQ(query(&loaded, pos, radius), scan(&loaded, pos, radius));
+	}
+}
@@ -0,0 +1,102 @@
+/*
+ * CLocalConnectionTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../../lib/serializer/Connection.h"
+#include "../../lib/NetPacks.h"
+
+TEST(CLocalConnectionTest, transfersDataBothWays)
+{
+	auto connections = CConnection::createLocalPair("first", "second");
+	auto & first = *connections.first;
+	auto & second = *connections.second;
+
+	EXPECT_TRUE(first.isLocal());
+	EXPECT_TRUE(second.isOpen());
+
+	std::vector<si32> initial = {1, -2, 1337};
+	std::string initialText = "Aiya!";
+	first << initial << initialText;
+	second << initialText;
+
+	std::vector<si32> loaded;
+	std::string loadedText, answer;
+	second >> loaded >> loadedText;
+	first >> answer;
+
+	EXPECT_EQ(loaded, initial);
+	EXPECT_EQ(loadedText, initialText);
+	EXPECT_EQ(answer, initialText);
+}
+
+TEST(CLocalConnectionTest, transfersPacks)
+{
+	auto connections = CConnection::createLocalPair("server", "client");
+
+	SystemMessage message("Hello");
+	*connections.first << &message;
+
+	CPack * pack = nullptr;
+	*connections.second >> pack;
+
+	auto loaded = dynamic_cast<SystemMessage *>(pack);
+	ASSERT_NE(loaded, nullptr);
+	EXPECT_EQ(loaded->text, message.text);
+	delete pack;
+}
+
+TEST(CLocalConnectionTest, closingWakesReader)
+{
+	auto connections = CConnection::createLocalPair("first", "second");
+
+	connections.first->close();
+	EXPECT_FALSE(connections.first->isOpen());
+
+	si32 value = 0;
+	EXPECT_THROW(*connections.second >> value, std::runtime_error);
+	EXPECT_FALSE(connections.second->isOpen());
+}
+
+TEST(CLocalConnectionTest, writingToClosedConnectionFails)
+{
+	auto connections = CConnection::createLocalPair("first", "second");
+
+	connections.second->close();
+
+	si32 value = 42;
+	EXPECT_THROW(*connections.first << value, std::runtime_error);
+	EXPECT_FALSE(connections.first->isOpen());
+	EXPECT_FALSE(connections.second->isOpen());
+}
+
+TEST(CLocalConnectionTest, transfersDataBetweenThreads)
+{
+	auto connections = CConnection::createLocalPair("first", "second");
+	const si32 count = 1000;
+
+	std::vector<si32> received;
+	boost::thread reader([&]()
+	{
+		si32 value = 0;
+		for(si32 i = 0; i < count; i++)
+		{
+			*connections.second >> value;
+			received.push_back(value);
+		}
+	});
+
+	for(si32 i = 0; i < count; i++)
+		*connections.first << i;
+	reader.join();
+
+	ASSERT_EQ(received.size(), (size_t)count);
+	for(si32 i = 0; i < count; i++)
+		EXPECT_EQ(received[i], i);
+}
@@ -0,0 +1,179 @@
+/*
+ * CMemorySerializerTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../../lib/serializer/CMemorySerializer.h"
+#include "../../lib/NetPacks.h"
+
+struct CMemorySerializerTest : testing::Test
+{
+	CMemorySerializer subject;
+};
+
+TEST_F(CMemorySerializerTest, vectorOfFundamentals)
+{
+	std::vector<si32> initial = {1, -2, 1337, 0x7fffffff};
+	std::vector<double> initialReal = {0.5, -1.25};
+	subject.oser & initial & initialReal;
+
+	std::vector<si32> loaded;
+	std::vector<double> loadedReal;
+	subject.iser & loaded & loadedReal;
+
+	EXPECT_EQ(loaded, initial);
+	EXPECT_EQ(loadedReal, initialReal);
+}
+
+TEST_F(CMemorySerializerTest, arrays)
+{
+	std::array<ui16, 3> initial = {{1, 2, 3}};
+	si8 initialRaw[2][2] = {{1, 2}, {3, 4}};
+	subject.oser & initial & initialRaw;
+
+	std::array<ui16, 3> loaded = {{0, 0, 0}};
+	si8 loadedRaw[2][2] = {{0, 0}, {0, 0}};
+	subject.iser & loaded & loadedRaw;
+
+	EXPECT_EQ(loaded, initial);
+	EXPECT_EQ(std::memcmp(loadedRaw, initialRaw, sizeof(initialRaw)), 0);
+}
+
+TEST_F(CMemorySerializerTest, elementWiseFormatIsPreserved)
+{
+	std::vector<ui32> initial = {1, 2, 3};
+	subject.oser & initial;
+
+	ui32 length = 0;
+	subject.iser & length;
+	EXPECT_EQ(length, initial.size());
+	for(ui32 value : initial)
+	{
+		ui32 loaded = 0;
+		subject.iser & loaded;
+		EXPECT_EQ(loaded, value);
+	}
+}
+
+TEST_F(CMemorySerializerTest, pointerIdOutOfSequence)
+{
+	ui8 notNull = 1;
+	ui32 pid = 0x7fffffff;
+	subject.oser & notNull & pid;
+
+	int3 * loaded = nullptr;
+	EXPECT_THROW(subject.iser & loaded, std::runtime_error);
+	EXPECT_EQ(loaded, nullptr);
+}
+
+TEST_F(CMemorySerializerTest, reversedEndianess)
+{
+	std::vector<ui16> initial16 = {0x0102, 0xa0b0};
+	std::vector<ui32> initial32 = {0x01020304};
+	std::vector<ui64> initial64 = {0x0102030405060708ULL};
+	subject.oser & initial16 & initial32 & initial64;
+
+	subject.iser.reverseEndianess = true;
+	std::vector<ui8> skippedLength(4);
+	std::vector<ui16> loaded16(initial16.size());
+	std::vector<ui32> loaded32(initial32.size());
+	std::vector<ui64> loaded64(initial64.size());
+
+	subject.read(skippedLength.data(), 4);
+	subject.iser.loadRange(loaded16.data(), loaded16.size());
+	subject.read(skippedLength.data(), 4);
+	subject.iser.loadRange(loaded32.data(), loaded32.size());
+	subject.read(skippedLength.data(), 4);
+	subject.iser.loadRange(loaded64.data(), loaded64.size());
+
+	EXPECT_EQ(loaded16[0], 0x0201);
+	EXPECT_EQ(loaded16[1], 0xb0a0);
+	EXPECT_EQ(loaded32[0], 0x04030201);
+	EXPECT_EQ(loaded64[0], 0x0807060504030201ULL);
+}
+
+TEST_F(CMemorySerializerTest, fowChangeOfWholeMap)
+{
+	// reveal of whole XL+U map with a few holes
+	FoWChange initial;
+	for(int z = 0; z < 2; z++)
+		for(int y = 0; y < 252; y++)
+			for(int x = 0; x < 252; x++)
+				if((x + y) % 97 != 0)
+					initial.tiles.insert(int3(x, y, z));
+
+	subject.oser & initial;
+	FoWChange loaded;
+	subject.iser & loaded;
+
+	std::unordered_set<int3, ShashInt3> loadedTiles;
+	TileRun::toTiles(loaded.runs, loadedTiles);
+	EXPECT_EQ(loadedTiles, initial.tiles);
+	EXPECT_TRUE(loaded.tiles.empty());
+	EXPECT_LT(loaded.runs.size(), 2 * 252 * 4);
+}
+
+TEST_F(CMemorySerializerTest, fowChangeWithRunsAndTiles)
+{
+	FoWChange initial;
+	initial.runs = {TileRun(int3(0, 0, 0), 10), TileRun(int3(3, 1, 0), 4)};
+	initial.tiles = {int3(10, 0, 0), int3(5, 5, 1)};
+	subject.oser & initial;
+	FoWChange loaded;
+	subject.iser & loaded;
+
+	std::unordered_set<int3, ShashInt3> expected = initial.tiles, loadedTiles;
+	TileRun::toTiles(initial.runs, expected);
+	TileRun::toTiles(loaded.runs, loadedTiles);
+	EXPECT_EQ(loadedTiles, expected);
+	EXPECT_EQ(16, loadedTiles.size());
+}
+
+TEST_F(CMemorySerializerTest, fowChangeWithInvalidRun)
+{
+	for(si32 length : {0, -1, TileRun::MAX_LENGTH, 0x7fffffff})
+	{
+		CMemorySerializer memory; //rest of rejected pack stays in stream
+		std::vector<TileRun> runs = {TileRun(int3(5, 0, 0), length)};
+		PlayerColor player(0);
+		ui8 mode = 1;
+		bool waitForDialogs = false;
+		memory.oser & runs & player & mode & waitForDialogs;
+
+		FoWChange loaded;
+		EXPECT_THROW(memory.iser & loaded, std::runtime_error) << "run of length " << length;
+	}
+}
+
+TEST_F(CMemorySerializerTest, fowChangeOutsideOfMap)
+{
+	subject.mapSize = int3(10, 10, 1);
+
+	FoWChange inside;
+	inside.tiles = {int3(5, 9, 0), int3(6, 9, 0), int3(9, 9, 0), int3(0, 0, 0)};
+	subject.oser & inside;
+	FoWChange loaded;
+	subject.iser & loaded;
+	std::unordered_set<int3, ShashInt3> loadedTiles;
+	TileRun::toTiles(loaded.runs, loadedTiles);
+	EXPECT_EQ(loadedTiles, inside.tiles);
+
+	for(int3 tile : {int3(10, 0, 0), int3(0, 10, 0), int3(0, 0, 1), int3(-1, 0, 0)})
+	{
+		CMemorySerializer memory;
+		memory.mapSize = subject.mapSize;
+
+		FoWChange outside;
+		outside.tiles = {int3(9, 0, 0), tile};
+		memory.oser & outside;
+
+		FoWChange rejected;
+		EXPECT_THROW(memory.iser & rejected, std::runtime_error) << "tile " << tile.toString();
+	}
+}